@@ -129,7 +129,15 @@ HEADERS += src/skyscraper.h \
            src/fxrotate.h \
            src/fxscanlines.h \
            src/nametools.h \
-           src/queue.h
+           src/queue.h \
+           src/filediscovery.h \
+           src/watcher.h \
+           src/iolimiter.h \
+           src/responsecache.h \
+           src/ratelimiter.h \
+           src/netfixtures.h \
+           src/quotaplanner.h \
+           src/passstats.h
 
 SOURCES += src/main.cpp \
            src/skyscraper.cpp \
@@ -183,7 +191,15 @@ SOURCES += src/main.cpp \
            src/fxrotate.cpp \
            src/fxscanlines.cpp \
            src/nametools.cpp \
-           src/queue.cpp
+           src/queue.cpp \
+           src/filediscovery.cpp \
+           src/watcher.cpp \
+           src/iolimiter.cpp \
+           src/responsecache.cpp \
+           src/ratelimiter.cpp \
+           src/netfixtures.cpp \
+           src/quotaplanner.cpp \
+           src/passstats.cpp
 
 SUBDIRS += \
     win32/skyscraper.pro
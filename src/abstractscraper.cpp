@@ -27,50 +27,70 @@
 
 #include "gameentry.h"
 #include "nametools.h"
+#include "passstats.h"
 #include "platform.h"
 #include "strtools.h"
 
+#include <QDir>
 #include <QDomDocument>
+#include <QMap>
 #include <QRegularExpression>
+#include <QStringBuilder>
+#include <QTemporaryFile>
+#include <QTimer>
+
+#include <algorithm>
 
 AbstractScraper::AbstractScraper(Settings *config,
                                  QSharedPointer<NetManager> manager,
                                  MatchType type)
-    : config(config), type(type) {
+    : config(config), type(type), manager(manager) {
     netComm = new NetComm(manager);
     connect(netComm, &NetComm::dataReady, &q, &QEventLoop::quit);
+    if (config->responseCacheDays > 0) {
+        // A refresh asks the servers again, unchanged data is still reused
+        netComm->setResponseCache(config->responseCacheDays * 24 * 60 * 60,
+                                  config->refresh);
+    }
 }
 
-AbstractScraper::~AbstractScraper() { netComm->deleteLater(); }
+AbstractScraper::~AbstractScraper() {
+    netComm->deleteLater();
+    for (auto *comm : mediaComms) {
+        comm->deleteLater();
+    }
+}
 
 void AbstractScraper::getSearchResults(QList<GameEntry> &gameEntries,
                                        QString searchName, QString platform) {
     netComm->request(searchUrlPre + searchName + searchUrlPost);
     q.exec();
     data = netComm->getData();
+    nomPos = 0;
+    nomEnd = -1;
 
     GameEntry game;
 
-    while (data.indexOf(searchResultPre.toUtf8()) != -1) {
+    while (checkNom(searchResultPre)) {
         nomNom(searchResultPre);
 
         // Digest until url
         for (const auto &nom : urlPre) {
             nomNom(nom);
         }
-        game.url = baseUrl + "/" + data.left(data.indexOf(urlPost.toUtf8()));
+        game.url = baseUrl + "/" + getNom(urlPost);
 
         // Digest until title
         for (const auto &nom : titlePre) {
             nomNom(nom);
         }
-        game.title = data.left(data.indexOf(titlePost.toUtf8()));
+        game.title = getNom(titlePost);
 
         // Digest until platform
         for (const auto &nom : platformPre) {
             nomNom(nom);
         }
-        game.platform = data.left(data.indexOf(platformPost.toUtf8()));
+        game.platform = getNom(platformPost);
 
         if (platformMatch(game.platform, platform)) {
             gameEntries.append(game);
@@ -82,6 +102,8 @@ void AbstractScraper::getGameData(GameEntry &game) {
     netComm->request(game.url);
     q.exec();
     data = netComm->getData();
+    nomPos = 0;
+    nomEnd = -1;
     // printf("URL IS: '%s'\n", game.url.toStdString().c_str());
     // printf("DATA IS:\n'%s'\n", data.data());
     populateGameEntry(game);
@@ -162,6 +184,7 @@ void AbstractScraper::populateGameEntry(GameEntry &game) {
         default:;
         }
     }
+    downloadQueuedMedia();
 }
 
 // TODO: openretro
@@ -178,9 +201,8 @@ void AbstractScraper::getDescription(GameEntry &game) {
         nomNom(nom);
     }
 
-    game.description = data.left(data.indexOf(descriptionPost.toUtf8()))
-                           .replace("&lt;", "<")
-                           .replace("&gt;", ">");
+    game.description =
+        getNom(descriptionPost).replace("&lt;", "<").replace("&gt;", ">");
     game.description = game.description.replace("\\n", "\n");
 
     // Remove all html tags within description
@@ -197,7 +219,7 @@ void AbstractScraper::getDeveloper(GameEntry &game) {
     for (const auto &nom : developerPre) {
         nomNom(nom);
     }
-    game.developer = data.left(data.indexOf(developerPost.toUtf8()));
+    game.developer = getNom(developerPost);
 }
 
 // TODO: openretro
@@ -213,7 +235,7 @@ void AbstractScraper::getPublisher(GameEntry &game) {
     for (const auto &nom : publisherPre) {
         nomNom(nom);
     }
-    game.publisher = data.left(data.indexOf(publisherPost.toUtf8()));
+    game.publisher = getNom(publisherPost);
 }
 
 // TODO: openretro
@@ -229,7 +251,7 @@ void AbstractScraper::getPlayers(GameEntry &game) {
     for (const auto &nom : playersPre) {
         nomNom(nom);
     }
-    game.players = data.left(data.indexOf(playersPost.toUtf8()));
+    game.players = getNom(playersPost);
 }
 
 // TODO: only for html scrape modules (currently none)
@@ -245,7 +267,7 @@ void AbstractScraper::getAges(GameEntry &game) {
     for (const auto &nom : agesPre) {
         nomNom(nom);
     }
-    game.ages = data.left(data.indexOf(agesPost.toUtf8()));
+    game.ages = getNom(agesPost);
 }
 
 // TODO: openretro
@@ -261,7 +283,7 @@ void AbstractScraper::getTags(GameEntry &game) {
     for (const auto &nom : tagsPre) {
         nomNom(nom);
     }
-    game.tags = data.left(data.indexOf(tagsPost.toUtf8()));
+    game.tags = getNom(tagsPost);
 }
 
 // TODO: openretro
@@ -277,7 +299,7 @@ void AbstractScraper::getRating(GameEntry &game) {
     for (const auto &nom : ratingPre) {
         nomNom(nom);
     }
-    game.rating = data.left(data.indexOf(ratingPost.toUtf8()));
+    game.rating = getNom(ratingPost);
     bool toDoubleOk = false;
     double rating = game.rating.toDouble(&toDoubleOk);
     if (toDoubleOk) {
@@ -300,8 +322,7 @@ void AbstractScraper::getReleaseDate(GameEntry &game) {
     for (const auto &nom : releaseDatePre) {
         nomNom(nom);
     }
-    game.releaseDate =
-        data.left(data.indexOf(releaseDatePost.toUtf8())).simplified();
+    game.releaseDate = getNom(releaseDatePost).simplified();
 }
 
 // TODO: openretro
@@ -317,8 +338,7 @@ void AbstractScraper::getCover(GameEntry &game) {
     for (const auto &nom : coverPre) {
         nomNom(nom);
     }
-    QString coverUrl =
-        data.left(data.indexOf(coverPost.toUtf8())).replace("&amp;", "&");
+    QString coverUrl = getNom(coverPost).replace("&amp;", "&");
     if (coverUrl.left(4) != "http") {
         coverUrl.prepend(baseUrl + (coverUrl.left(1) == "/" ? "" : "/"));
     }
@@ -331,15 +351,20 @@ void AbstractScraper::getScreenshot(GameEntry &game) {
         return;
     }
     // Check that we have enough screenshots
-    int screens = data.count(screenshotCounter.toUtf8());
+    const QByteArray counter = screenshotCounter.toUtf8();
+    int screens = 0;
+    for (int pos = indexOfNom(counter, nomPos); pos != -1;
+         pos = indexOfNom(counter, pos + counter.length())) {
+        screens++;
+    }
     if (screens >= 1) {
         for (int a = 0; a < screens - (screens / 2); a++) {
             for (const auto &nom : screenshotPre) {
                 nomNom(nom);
             }
         }
-        QString screenshotUrl = data.left(data.indexOf(screenshotPost.toUtf8()))
-                                    .replace("&amp;", "&");
+        QString screenshotUrl =
+            getNom(screenshotPost).replace("&amp;", "&");
         if (screenshotUrl.left(4) != "http") {
             screenshotUrl.prepend(baseUrl +
                                   (screenshotUrl.left(1) == "/" ? "" : "/"));
@@ -361,8 +386,7 @@ void AbstractScraper::getWheel(GameEntry &game) {
     for (const auto &nom : wheelPre) {
         nomNom(nom);
     }
-    QString wheelUrl =
-        data.left(data.indexOf(wheelPost.toUtf8())).replace("&amp;", "&");
+    QString wheelUrl = getNom(wheelPost).replace("&amp;", "&");
     if (wheelUrl.left(4) != "http") {
         wheelUrl.prepend(baseUrl + (wheelUrl.left(1) == "/" ? "" : "/"));
     }
@@ -382,8 +406,7 @@ void AbstractScraper::getMarquee(GameEntry &game) {
     for (const auto &nom : marqueePre) {
         nomNom(nom);
     }
-    QString marqueeUrl =
-        data.left(data.indexOf(marqueePost.toUtf8())).replace("&amp;", "&");
+    QString marqueeUrl = getNom(marqueePost).replace("&amp;", "&");
     if (marqueeUrl.left(4) != "http") {
         marqueeUrl.prepend(baseUrl + (marqueeUrl.left(1) == "/" ? "" : "/"));
     }
@@ -406,8 +429,7 @@ void AbstractScraper::getTexture(GameEntry &game) {
         nomNom(nom);
     }
 
-    QString textureUrl =
-        data.left(data.indexOf(texturePost.toUtf8())).replace("&amp;", "&");
+    QString textureUrl = getNom(texturePost).replace("&amp;", "&");
     if (textureUrl.left(4) != "http") {
         textureUrl.prepend(baseUrl + (textureUrl.left(1) == "/" ? "" : "/"));
     }
@@ -427,15 +449,12 @@ void AbstractScraper::getVideo(GameEntry &game) {
     for (const auto &nom : videoPre) {
         nomNom(nom);
     }
-    QString videoUrl =
-        data.left(data.indexOf(videoPost.toUtf8())).replace("&amp;", "&");
+    QString videoUrl = getNom(videoPost).replace("&amp;", "&");
     if (videoUrl.left(4) != "http") {
         videoUrl.prepend(baseUrl + (videoUrl.left(1) == "/" ? "" : "/"));
     }
 
-    game.videoData = downloadMedia(videoUrl, false);
-    if (!game.videoData.isEmpty())
-        game.videoFormat = videoUrl.right(3);
+    queueVideo({videoUrl}, game, videoUrl.right(3));
 }
 
 QByteArray AbstractScraper::downloadMedia(const QString &url, bool isImage) {
@@ -450,17 +469,202 @@ QByteArray AbstractScraper::downloadMedia(const QString &url, bool isImage) {
     return d;
 }
 
+void AbstractScraper::queueMedia(const QStringList &urls,
+                                 const MediaCheck &check, bool isImage,
+                                 int attempts) {
+    QStringList validUrls;
+    for (const auto &url : urls) {
+        if (!url.isEmpty()) {
+            validUrls.append(url);
+        }
+    }
+    if (!validUrls.isEmpty()) {
+        mediaQueue.append({validUrls, check, isImage, qMax(attempts, 1)});
+    }
+}
+
+void AbstractScraper::queueVideo(const QStringList &urls, GameEntry &game,
+                                 const QString &format, int attempts) {
+    QDir videoDir(config->cacheFolder % "/videos/" % config->scraper);
+    if (!videoDir.mkpath(".")) {
+        return;
+    }
+    // Reserve a unique name, every attempt overwrites the same file
+    QTemporaryFile tmpFile(videoDir.absoluteFilePath(game.cacheId %
+                                                     ".XXXXXX.part"));
+    tmpFile.setAutoRemove(false);
+    if (!tmpFile.open()) {
+        return;
+    }
+    const QString fileName = tmpFile.fileName();
+    tmpFile.close();
+    int idx = mediaQueue.size();
+    queueMedia(
+        urls,
+        [&game, fileName, format](const QByteArray &,
+                                  const QByteArray &contentType) {
+            QString videoFormat = format;
+            if (videoFormat.isEmpty()) {
+                QByteArray type = contentType.toLower();
+                if (!type.startsWith("video/")) {
+                    return false;
+                }
+                videoFormat = type.mid(type.indexOf("/") + 1);
+            }
+            if (QFileInfo(fileName).size() <= 4096) {
+                return false;
+            }
+            game.videoData.clear();
+            game.videoTempFile = fileName;
+            game.videoFormat = videoFormat;
+            return true;
+        },
+        false, attempts);
+    if (mediaQueue.size() > idx) {
+        mediaQueue.last().streamFile = fileName;
+        mediaQueue.last().sizeExceeded = &game.videoSizeExceeded;
+    } else {
+        QFile::remove(fileName);
+    }
+}
+
+void AbstractScraper::queueMedia(const QStringList &urls, QByteArray &target,
+                                 bool isImage) {
+    queueMedia(
+        urls,
+        [&target](const QByteArray &d, const QByteArray &) {
+            target = d;
+            return true;
+        },
+        isImage);
+}
+
+void AbstractScraper::downloadQueuedMedia() {
+    if (mediaQueue.isEmpty()) {
+        return;
+    }
+    QList<MediaRequest> pending;
+    pending.swap(mediaQueue);
+
+    // Each NetComm still waits for its turn at the RateLimiter, so this only
+    // overlaps transfers as far as the module's request rate allows
+    const int concurrency = 4;
+    while (mediaComms.size() < qMin(concurrency, pending.size())) {
+        NetComm *comm = new NetComm(manager);
+        if (config->responseCacheDays > 0) {
+            comm->setResponseCache(config->responseCacheDays * 24 * 60 * 60,
+                                   config->refresh);
+        }
+        mediaComms.append(comm);
+    }
+
+    QEventLoop loop;
+    QMap<NetComm *, int> active;
+    int next = 0;
+    auto start = [&](NetComm *comm, int idx) {
+        active[comm] = idx;
+        const MediaRequest &r = pending.at(idx);
+        if (!r.streamFile.isEmpty()) {
+            comm->setStreamFile(r.streamFile, config->videoSizeLimit);
+        }
+        comm->request(r.urls.at(r.urlIdx));
+    };
+    // request() may block in the RateLimiter, which runs an event loop of its
+    // own. Starting from within a dataReady handler would nest those, so the
+    // follow-up request is posted to the outer loop instead
+    auto startLater = [&](NetComm *comm, int idx) {
+        active[comm] = idx;
+        QTimer::singleShot(0, &loop,
+                           [&start, comm, idx]() { start(comm, idx); });
+    };
+    for (auto *comm : mediaComms) {
+        connect(comm, &NetComm::dataReady, &loop, [&, comm]() {
+            const int idx = active.value(comm);
+            MediaRequest &r = pending[idx];
+            QImage img;
+            bool accepted = false;
+            if (comm->getError() == QNetworkReply::NoError &&
+                (!r.isImage || img.loadFromData(comm->getData()))) {
+                accepted = r.check(comm->getData(), comm->getContentType());
+            }
+            r.accepted = accepted;
+            if (!accepted) {
+                bool tooLarge = comm->isSizeExceeded();
+                if (tooLarge && r.sizeExceeded != nullptr) {
+                    *r.sizeExceeded = true;
+                }
+                // The same url won't get any smaller, try the next one
+                if (tooLarge || ++r.attempt >= r.attempts) {
+                    r.attempt = 0;
+                    r.urlIdx++;
+                }
+                if (r.urlIdx < r.urls.size()) {
+                    startLater(comm, idx);
+                    return;
+                }
+            }
+            if (next < pending.size()) {
+                startLater(comm, next++);
+                return;
+            }
+            active.remove(comm);
+            if (active.isEmpty()) {
+                loop.quit();
+            }
+        });
+    }
+    // A request may wait for the RateLimiter, finished downloads are already
+    // handled meanwhile
+    for (auto *comm : mediaComms) {
+        if (next >= pending.size()) {
+            break;
+        }
+        if (!active.contains(comm)) {
+            start(comm, next++);
+        }
+    }
+    if (!active.isEmpty()) {
+        loop.exec();
+    }
+    for (const auto &r : pending) {
+        if (!r.streamFile.isEmpty() && !r.accepted) {
+            QFile::remove(r.streamFile);
+        }
+    }
+}
+
 void AbstractScraper::nomNom(const QString nom, bool including) {
-    data.remove(0, data.indexOf(nom.toUtf8()) + (including ? nom.length() : 0));
+    const QByteArray n = nom.toUtf8();
+    int pos = indexOfNom(n, nomPos);
+    if (pos != -1) {
+        nomPos = pos + (including ? n.length() : 0);
+    }
 }
 
 bool AbstractScraper::checkNom(const QString nom) {
-    if (data.indexOf(nom.toUtf8()) != -1) {
+    if (indexOfNom(nom.toUtf8(), nomPos) != -1) {
         return true;
     }
     return false;
 }
 
+QByteArray AbstractScraper::getNom(const QString &post) {
+    int end = indexOfNom(post.toUtf8(), nomPos);
+    if (end == -1) {
+        // Like the rest of the page
+        end = nomEnd == -1 ? data.size() : nomEnd;
+    }
+    return data.mid(nomPos, qMax(end - nomPos, 0));
+}
+
+int AbstractScraper::indexOfNom(const QByteArray &nom, const int from) {
+    int pos = data.indexOf(nom, from);
+    if (pos != -1 && nomEnd != -1 && pos + nom.length() > nomEnd) {
+        return -1;
+    }
+    return pos;
+}
+
 QString AbstractScraper::lookupArcadeTitle(const QString &baseName) {
     if (config->arcadePlatform) {
         return config->mameMap[baseName];
@@ -521,7 +725,9 @@ QList<QString> AbstractScraper::getSearchNames(const QFileInfo &info,
 
     Q_ASSERT(!searchName.isEmpty());
 
+    searchVariants.clear();
     searchNames.append(NameTools::getUrlQueryName(searchName));
+    searchVariants.append("exact");
 
     // If search name has a subtitle, also search without subtitle
     if (searchName.contains(":") || searchName.contains(" - ")) {
@@ -530,8 +736,10 @@ QList<QString> AbstractScraper::getSearchNames(const QFileInfo &info,
         noSubtitle = noSubtitle.left(noSubtitle.indexOf(" - ")).simplified();
         // Only add if longer than 3. We don't want to search for "the" for
         // instance
-        if (noSubtitle.length() > 3)
+        if (noSubtitle.length() > 3) {
             searchNames.append(NameTools::getUrlQueryName(noSubtitle));
+            searchVariants.append("nosubtitle");
+        }
     }
 
     // If the search name has a Roman numeral, also search for an integer
@@ -544,6 +752,7 @@ QList<QString> AbstractScraper::getSearchNames(const QFileInfo &info,
             searchName = NameTools::convertToRomanNumeral(searchName);
         }
         searchNames.append(NameTools::getUrlQueryName(searchName));
+        searchVariants.append("numeral");
 
         // If search name has a subtitle, also search without subtitle
         if (searchName.contains(":") || searchName.contains(" - ")) {
@@ -555,6 +764,7 @@ QList<QString> AbstractScraper::getSearchNames(const QFileInfo &info,
                 // Only add if longer than 3. We don't want to search for "the"
                 // for instance
                 searchNames.append(NameTools::getUrlQueryName(noSubtitle));
+                searchVariants.append("numeralnosubtitle");
             }
         }
     }
@@ -643,12 +853,17 @@ void AbstractScraper::runPasses(QList<GameEntry> &gameEntries,
     }
 
     QList<QString> searchNames;
+    searchVariants.clear();
+    passVariant = "";
     if (!config->searchName.isEmpty()) {
         // set the string provided by "--query"
         searchNames.append(applyQuerySearchName(config->searchName));
     } else {
         searchNames = getSearchNames(info, debug);
     }
+    // Only the variants of a regular search are counted
+    bool countPasses = config->searchName.isEmpty() &&
+                       searchVariants.size() == searchNames.size();
 
     if (searchNames.isEmpty()) {
         return;
@@ -662,10 +877,37 @@ void AbstractScraper::runPasses(QList<GameEntry> &gameEntries,
         }
     }
 
+    // Variants that led to a match on this platform most often go first. With
+    // many candidates per search the exact name stays first, a less specific
+    // one would come up with some candidates almost every time
+    QList<int> order;
+    if (countPasses) {
+        order = PassStats::get().getOrder(config->platform, config->scraper,
+                                          searchVariants,
+                                          type == MatchType::MATCH_MANY);
+    } else {
+        for (int i = 0; i < searchNames.size(); ++i) {
+            order.append(i);
+        }
+    }
+    if (config->verbosity >= 3 &&
+        !std::is_sorted(order.begin(), order.end())) {
+        QStringList passes;
+        for (const auto &idx : order) {
+            passes.append(QString::number(idx + 1));
+        }
+        debug.append("Search name order: " + passes.join(", ") + "\n");
+    }
+
     int pass = 0;
-    for (const auto &sn : searchNames) {
+    for (const auto &idx : order) {
+        const QString &sn = searchNames.at(idx);
         output.append("\033[1;35mPass " + QString::number(++pass) + "\033[0m ");
         getSearchResults(gameEntries, sn, config->platform);
+        if (countPasses) {
+            PassStats::get().addTry(config->platform, config->scraper,
+                                    searchVariants.at(idx));
+        }
         if (config->verbosity >= 3) {
             debug.append("Tried with: '" + sn + "'\n");
             debug.append("Platform  : " + config->platform + "\n");
@@ -691,6 +933,10 @@ void AbstractScraper::runPasses(QList<GameEntry> &gameEntries,
             }
         }
         if (!gameEntries.isEmpty()) {
+            if (countPasses) {
+                // Counted as a hit once the match is accepted
+                passVariant = searchVariants.at(idx);
+            }
             break;
         }
     }
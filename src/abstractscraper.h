@@ -37,6 +37,8 @@
 #include <QList>
 #include <QSettings>
 
+#include <functional>
+
 class AbstractScraper : public QObject {
     Q_OBJECT
 
@@ -53,8 +55,18 @@ public:
     virtual void runPasses(QList<GameEntry> &gameEntries, const QFileInfo &info,
                            QString &output, QString &debug);
 
+    // Number of games a module can resolve with one request, 0 if it can't
+    virtual int getBatchSize() { return 0; };
+    // Resolves the given files in advance with as few requests as possible.
+    // Called before runPasses() with the current and the upcoming files
+    virtual void prefetch(const QList<QFileInfo> &infos) { (void)infos; };
+
     int reqRemaining = -1;
     MatchType getType() const { return type; };
+    // Search name variant which found the candidates of the last
+    // runPasses(), empty if the module has no variants
+    QString getPassVariant() const { return passVariant; };
+    int getNetworkFailures() { return netComm->getFailures(); };
 
 #ifdef TESTING
     QList<QString> getRegionPrios() { return regionPrios; }
@@ -85,23 +97,60 @@ protected:
     virtual void getManual(GameEntry &game) { (void)game; };
     virtual void getFanart(GameEntry &game) { (void)game; };
 
+    // HTML extraction over data: nomNom() moves the cursor nomPos past (or
+    // onto) the next nom, checkNom() tells if there is one ahead and getNom()
+    // returns the text from the cursor up to post. Nothing at or after nomEnd
+    // is found. data itself stays as is
     virtual void nomNom(const QString nom, bool including = true);
     bool checkNom(const QString nom);
+    QByteArray getNom(const QString &post);
+    // Position of nom from the given position on, -1 if there is none before
+    // nomEnd
+    int indexOfNom(const QByteArray &nom, const int from);
 
     virtual bool platformMatch(QString found, QString platform);
     virtual int getPlatformId(const QString);
     virtual QString applyQuerySearchName(QString query) { return query; };
+    // Largest width and height needed of a downloaded image (except fanart),
+    // 0 if the cache keeps the original size
+    int getMaxImageSize() { return config->cacheResize ? CACHERESIZEMAX : 0; };
 
     QString lookupSearchName(const QFileInfo &info, const QString &baseName,
                              QString &debug);
     QString lookupAliasMap(const QString &baseName, QString &debug);
     QByteArray downloadMedia(const QString &url, bool isImage = true);
 
+    // Gets data and content type of a download, returns false to reject it
+    typedef std::function<bool(const QByteArray &, const QByteArray &)>
+        MediaCheck;
+    // Queues a media download of the current game. The queued downloads run
+    // concurrently after populateGameEntry() has called all getters. The urls
+    // are tried in order, each up to attempts times, until check accepts one
+    void queueMedia(const QStringList &urls, const MediaCheck &check,
+                    bool isImage = true, int attempts = 1);
+    void queueMedia(const QStringList &urls, QByteArray &target,
+                    bool isImage = true);
+    // Queues a video download, written to the cache folder as it arrives.
+    // Without format it is taken from the content type
+    void queueVideo(const QStringList &urls, GameEntry &game,
+                    const QString &format = "", int attempts = 1);
+    void downloadQueuedMedia();
+
     MatchType type = ABSTRACT;
 
+    // Kind of each name returned by getSearchNames() ("exact", "nosubtitle",
+    // "numeral", "numeralnosubtitle"). Modules with their own search names
+    // leave it empty and keep their order
+    QStringList searchVariants;
+    QString passVariant;
+
     QList<int> fetchOrder;
 
     QByteArray data;
+    // Cursor of nomNom() into data and the end of the part to search, -1 for
+    // the end of data. Reset both whenever data is replaced
+    int nomPos = 0;
+    int nomEnd = -1;
 
     QString baseUrl;
     QString searchUrlPre;
@@ -153,6 +202,22 @@ protected:
     QEventLoop q; // Event loop for use when waiting for data from NetComm.
 
 private:
+    struct MediaRequest {
+        QStringList urls;
+        MediaCheck check;
+        bool isImage;
+        int attempts;
+        QString streamFile = "";
+        // Set if a download is cancelled for its size
+        bool *sizeExceeded = nullptr;
+        int urlIdx = 0;
+        int attempt = 0;
+        bool accepted = false;
+    };
+    QList<MediaRequest> mediaQueue;
+    QList<NetComm *> mediaComms;
+    QSharedPointer<NetManager> manager;
+
     QString lookupArcadeTitle(const QString &baseName);
 #ifndef TESTING
     void detectRegionFromFilename(const QFileInfo &info);
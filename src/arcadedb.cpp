@@ -58,22 +58,60 @@ ArcadeDB::ArcadeDB(Settings *config, QSharedPointer<NetManager> manager)
     fetchOrder.append(GameEntry::Elem::VIDEO);
 }
 
-void ArcadeDB::getSearchResults(QList<GameEntry> &gameEntries,
-                                QString searchName, QString platform) {
-    QString url = searchUrlPre + searchName;
+void ArcadeDB::prefetch(const QList<QFileInfo> &infos) {
+    QString debug;
+    const QString current = getSearchNames(infos.first(), debug).first();
+    if (prefetched.contains(current) || batched.contains(current)) {
+        return;
+    }
+    // The current file starts a new batch, it also covers the upcoming files
+    // not resolved yet
+    QStringList names;
+    for (const auto &info : infos) {
+        QString name = getSearchNames(info, debug).first();
+        if (!prefetched.contains(name) && !batched.contains(name) &&
+            !names.contains(name)) {
+            names.append(name);
+        }
+    }
+    if (names.size() < 2) {
+        return;
+    }
+
+    QString url = searchUrlPre + names.join(";");
     qDebug() << url;
     netComm->request(url);
     q.exec();
     data = netComm->getData();
 
-    if (data.indexOf("{\"release\":1,\"result\":[]}") != -1) {
-        return;
-    }
     jsonDoc = QJsonDocument::fromJson(data);
     if (jsonDoc.isEmpty()) {
+        // Leave them to the single requests of getSearchResults()
+        return;
+    }
+    for (const auto &name : names) {
+        batched.insert(name);
+    }
+    const QJsonArray results = jsonDoc.object().value("result").toArray();
+    for (const auto &result : results) {
+        QJsonObject game = result.toObject();
+        prefetched.insert(game.value("game_name").toString(), game);
+    }
+    qDebug() << "Prefetched" << results.size() << "of" << names.size()
+             << "games";
+}
+
+void ArcadeDB::getSearchResults(QList<GameEntry> &gameEntries,
+                                QString searchName, QString platform) {
+    if (prefetched.contains(searchName)) {
+        jsonObj = prefetched.take(searchName);
+        batched.remove(searchName);
+    } else if (batched.remove(searchName)) {
+        // The batch already asked for it, the database doesn't know it
+        return;
+    } else if (!requestGame(searchName)) {
         return;
     }
-    jsonObj = jsonDoc.object().value("result").toArray().first().toObject();
 
     if (jsonObj.value("title") == QJsonValue::Undefined) {
         return;
@@ -87,6 +125,25 @@ void ArcadeDB::getSearchResults(QList<GameEntry> &gameEntries,
     gameEntries.append(game);
 }
 
+bool ArcadeDB::requestGame(const QString &searchName) {
+    // Not part of a batch
+    QString url = searchUrlPre + searchName;
+    qDebug() << url;
+    netComm->request(url);
+    q.exec();
+    data = netComm->getData();
+
+    if (data.indexOf("{\"release\":1,\"result\":[]}") != -1) {
+        return false;
+    }
+    jsonDoc = QJsonDocument::fromJson(data);
+    if (jsonDoc.isEmpty()) {
+        return false;
+    }
+    jsonObj = jsonDoc.object().value("result").toArray().first().toObject();
+    return true;
+}
+
 void ArcadeDB::getGameData(GameEntry &game) { populateGameEntry(game); }
 
 void ArcadeDB::getReleaseDate(GameEntry &game) {
@@ -122,53 +179,31 @@ void ArcadeDB::getDescription(GameEntry &game) {
 
 void ArcadeDB::getCover(GameEntry &game) {
     // try flyer first, title (screen) as failsafe
-    for (auto const &key :
-         QStringList({"url_image_flyer", "url_image_title"})) {
-        QString url = jsonObj.value(key).toString();
-        if (url.isEmpty()) {
-            continue;
-        }
-        game.coverData = downloadMedia(url);
-        if (!game.coverData.isEmpty()) {
-            break;
-        }
-    }
+    queueMedia({jsonObj.value("url_image_flyer").toString(),
+                jsonObj.value("url_image_title").toString()},
+               game.coverData);
 }
 
 void ArcadeDB::getScreenshot(GameEntry &game) {
-    QString url = jsonObj.value("url_image_ingame").toString();
-    if (!url.isEmpty()) {
-        game.screenshotData = downloadMedia(url);
-    }
+    queueMedia({jsonObj.value("url_image_ingame").toString()},
+               game.screenshotData);
 }
 
 void ArcadeDB::getWheel(GameEntry &game) {
-    game.wheelData = downloadMedia(baseUrl + "/media/mame.current/decals/" +
-                                   jsonObj["game_name"].toString() + ".png");
+    queueMedia({baseUrl + "/media/mame.current/decals/" +
+                jsonObj["game_name"].toString() + ".png"},
+               game.wheelData);
 }
 
 void ArcadeDB::getMarquee(GameEntry &game) {
-    QString url = jsonObj.value("url_image_marquee").toString();
-    if (!url.isEmpty()) {
-        game.marqueeData =
-            downloadMedia(jsonObj.value("url_image_marquee").toString());
-    }
+    queueMedia({jsonObj.value("url_image_marquee").toString()},
+               game.marqueeData);
 }
 
 void ArcadeDB::getVideo(GameEntry &game) {
-    for (auto const &key :
-         QStringList({"url_video_shortplay_hd", "url_video_shortplay"})) {
-        QString url = jsonObj.value(key).toString();
-        if (!url.isEmpty()) {
-            game.videoData = downloadMedia(url, false);
-            if (game.videoData.length() > 4096) {
-                game.videoFormat = "mp4";
-                break;
-            } else {
-                game.videoData.clear();
-            }
-        }
-    }
+    queueVideo({jsonObj.value("url_video_shortplay_hd").toString(),
+                jsonObj.value("url_video_shortplay").toString()},
+               game, "mp4");
 }
 
 QList<QString> ArcadeDB::getSearchNames(const QFileInfo &info, QString &debug) {
@@ -28,20 +28,25 @@
 
 #include "abstractscraper.h"
 
+#include <QHash>
 #include <QJsonDocument>
 #include <QJsonObject>
+#include <QSet>
 
 class ArcadeDB : public AbstractScraper {
     Q_OBJECT
 
 public:
     ArcadeDB(Settings *config, QSharedPointer<NetManager> manager);
+    int getBatchSize() override { return 50; };
+    void prefetch(const QList<QFileInfo> &infos) override;
 
 private:
     QList<QString> getSearchNames(const QFileInfo &info,
                                   QString &debug) override;
     void getSearchResults(QList<GameEntry> &gameEntries, QString searchName,
                           QString platform) override;
+    bool requestGame(const QString &searchName);
     void getGameData(GameEntry &game) override;
     void getReleaseDate(GameEntry &game) override;
     void getPlayers(GameEntry &game) override;
@@ -56,6 +61,11 @@ private:
 
     QJsonDocument jsonDoc;
     QJsonObject jsonObj;
+
+    // Games resolved by prefetch(), keyed by MAME short name
+    QHash<QString, QJsonObject> prefetched;
+    // Short names already part of a batch request and not looked up yet
+    QSet<QString> batched;
 };
 
 #endif // ARCADEDB_H
@@ -28,6 +28,7 @@
 
 #include "cli.h"
 #include "config.h"
+#include "iolimiter.h"
 #include "nametools.h"
 #include "queue.h"
 #include "skyscraper.h"
@@ -49,9 +50,11 @@
 // user defined resource cache entries
 const QString SRC_USER = "user";
 
-// quickids.xml and db.xml
+// quickids.xml, notfound.xml and db.xml
 const QString Q_ELEM = "quickid";
+const QString N_ELEM = "notfound";
 const QString R_ELEM = "resource";
+const QString ATTR_SEARCH = "search";
 const QString ATTR_FILEPATH = "filepath";
 const QString ATTR_ID = "id";
 const QString ATTR_SHA1_LEGACY = "sha1";
@@ -142,6 +145,17 @@ bool Cache::createFolders(const QString &scraper) {
         }
     }
 
+    // Video downloads of an interrupted run. Recent ones may belong to
+    // another instance still running
+    QDir videoDir(QString("%1/videos/%2").arg(cacheDir.path(), scraper));
+    QDateTime staleTime = QDateTime::currentDateTime().addSecs(-60 * 60);
+    for (const auto &part :
+         videoDir.entryInfoList({"*.part"}, QDir::Files | QDir::Hidden)) {
+        if (part.lastModified() < staleTime) {
+            QFile::remove(part.absoluteFilePath());
+        }
+    }
+
     // Copy priorities.xml example file to cache folder if it doesn't already
     // exist
     QFile::copy("cache/priorities.xml.example", prioFilePath());
@@ -176,6 +190,8 @@ bool Cache::read() {
         printf("\033[1;32mDone!\033[0m\n");
     }
 
+    readNotFounds();
+
     QFile cacheFile(dbFilePath());
     if (cacheFile.open(QIODevice::ReadOnly)) {
         printf("Building file lookup cache, please wait... ");
@@ -923,6 +939,9 @@ bool Cache::purgeAll(const bool unattend) {
         it.remove();
         purged++;
     }
+    // Scrape everything again after a purge, including earlier misses
+    notFounds.clear();
+    notFoundsChanged = true;
     printf("\033[1;32m Done!\033[0m\n");
     if (purged == 0) {
         printf("No resources for the current platform found in the resource "
@@ -1257,6 +1276,19 @@ bool Cache::vacuumResources(const QString inputFolder, const QString filter,
         printf("No cache id's found, something is wrong, cancelling...\n");
         return false;
     }
+    // Misses of files no longer present are obsolete as well
+    QSet<QString> cacheIdSet;
+    for (const auto &cacheId : cacheIdList) {
+        cacheIdSet.insert(cacheId);
+    }
+    QMutableMapIterator<QString, qint64> notFoundIt(notFounds);
+    while (notFoundIt.hasNext()) {
+        QString cacheId = notFoundIt.next().key().section('\t', 0, 0);
+        if (!cacheIdSet.contains(cacheId)) {
+            notFoundIt.remove();
+            notFoundsChanged = true;
+        }
+    }
 
     int vacuumed = 0;
     {
@@ -1462,6 +1494,8 @@ void Cache::readPriorities() {
 bool Cache::write(const bool onlyQuickId) {
     QMutexLocker locker(&cacheMutex);
 
+    writeNotFounds();
+
     QFile quickIdFile(quickIdFilePath());
     if (quickIdFile.open(QIODevice::WriteOnly)) {
         printf("Writing quick id xml, please wait... ");
@@ -1654,6 +1688,9 @@ void Cache::addResources(GameEntry &entry, const Settings &config,
         exit(1);
     }
     if (entry.cacheId.isEmpty()) {
+        if (!entry.videoTempFile.isEmpty()) {
+            QFile::remove(entry.videoTempFile);
+        }
         return;
     }
     const QString cacheAbsolutePath = cacheDir.path();
@@ -1690,7 +1727,9 @@ void Cache::addResources(GameEntry &entry, const Settings &config,
         {"texture", !entry.textureData.isEmpty()},
         {"manual", !entry.manualData.isEmpty()},
         {"fanart", !entry.fanartData.isEmpty()},
-        {"video", !entry.videoData.isEmpty() && entry.videoFormat != ""}};
+        {"video",
+         (!entry.videoData.isEmpty() || !entry.videoTempFile.isEmpty()) &&
+             entry.videoFormat != ""}};
 
     for (auto const &t : binTypes()) {
         if (binResources.value(t)) {
@@ -1702,6 +1741,11 @@ void Cache::addResources(GameEntry &entry, const Settings &config,
             addResource(resource, entry, cacheAbsolutePath, config, output);
         }
     }
+    // Left over if the video was cached already or could not be moved
+    if (!entry.videoTempFile.isEmpty()) {
+        QFile::remove(entry.videoTempFile);
+        entry.videoTempFile = "";
+    }
 }
 
 void Cache::addResource(Resource &resource, GameEntry &entry,
@@ -1749,7 +1793,7 @@ void Cache::addResource(Resource &resource, GameEntry &entry,
                 QImage image;
                 if (imageData->size() > 0 && image.loadFromData(*imageData) &&
                     !image.isNull()) {
-                    int max = 800;
+                    int max = CACHERESIZEMAX;
                     if (image.width() > max || image.height() > max) {
                         image = image.scaled(max, max, Qt::KeepAspectRatio,
                                              Qt::SmoothTransformation);
@@ -1795,11 +1839,23 @@ void Cache::addResource(Resource &resource, GameEntry &entry,
                 imageData->clear();
             }
         } else if (resource.type == "video") {
-            if (entry.videoData.size() <= config.videoSizeLimit) {
+            qint64 videoSize = entry.videoTempFile.isEmpty()
+                                   ? entry.videoData.size()
+                                   : QFileInfo(entry.videoTempFile).size();
+            if (videoSize <= config.videoSizeLimit) {
                 QFile f(cacheFile);
-                if (f.open(QIODevice::WriteOnly)) {
+                bool written = false;
+                if (!entry.videoTempFile.isEmpty()) {
+                    // Streamed download, the complete file is just moved
+                    // into place
+                    f.remove();
+                    written = QFile::rename(entry.videoTempFile, cacheFile);
+                } else if (f.open(QIODevice::WriteOnly)) {
                     f.write(entry.videoData);
                     f.close();
+                    written = true;
+                }
+                if (written) {
                     if (!config.videoConvertCommand.isEmpty()) {
                         output.append("Video conversion: ");
                         if (doVideoConvert(resource, cacheFile,
@@ -1961,6 +2017,76 @@ QString Cache::getQuickId(const QFileInfo &info) {
     return QString();
 }
 
+void Cache::addNotFound(const QString &cacheId, const QString &scraper,
+                        const QString &searchName) {
+    QMutexLocker locker(&notFoundMutex);
+    notFounds[cacheId % "\t" % scraper % "\t" % searchName] =
+        QDateTime::currentSecsSinceEpoch();
+    notFoundsChanged = true;
+}
+
+bool Cache::isNotFound(const QString &cacheId, const QString &scraper,
+                       const QString &searchName, const int days) {
+    QMutexLocker locker(&notFoundMutex);
+    QString key = cacheId % "\t" % scraper % "\t" % searchName;
+    if (days <= 0 || !notFounds.contains(key)) {
+        return false;
+    }
+    return QDateTime::currentSecsSinceEpoch() - notFounds[key] <
+           (qint64)days * 24 * 60 * 60;
+}
+
+void Cache::readNotFounds() {
+    QFile notFoundFile(notFoundFilePath());
+    if (!notFoundFile.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    QXmlStreamReader xml(&notFoundFile);
+    while (!xml.atEnd()) {
+        if (xml.readNext() != QXmlStreamReader::StartElement ||
+            xml.name() != N_ELEM) {
+            continue;
+        }
+        QXmlStreamAttributes attribs = xml.attributes();
+        if (!attribs.hasAttribute(ATTR_ID) || !attribs.hasAttribute(ATTR_SRC) ||
+            !attribs.hasAttribute(ATTR_TS)) {
+            continue;
+        }
+        notFounds[attribs.value(ATTR_ID).toString() % "\t" %
+                  attribs.value(ATTR_SRC).toString() % "\t" %
+                  attribs.value(ATTR_SEARCH).toString()] =
+            attribs.value(ATTR_TS).toLongLong();
+    }
+    notFoundFile.close();
+}
+
+void Cache::writeNotFounds() {
+    QMutexLocker locker(&notFoundMutex);
+    if (!notFoundsChanged) {
+        return;
+    }
+    QFile notFoundFile(notFoundFilePath());
+    if (!notFoundFile.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    QXmlStreamWriter xml(&notFoundFile);
+    xml.setAutoFormatting(true);
+    xml.writeStartDocument();
+    xml.writeStartElement("notfounds");
+    for (auto it = notFounds.constBegin(); it != notFounds.constEnd(); ++it) {
+        xml.writeStartElement(N_ELEM);
+        xml.writeAttribute(ATTR_ID, it.key().section('\t', 0, 0));
+        xml.writeAttribute(ATTR_SRC, it.key().section('\t', 1, 1));
+        xml.writeAttribute(ATTR_SEARCH, it.key().section('\t', 2));
+        xml.writeAttribute(ATTR_TS, QString::number(it.value()));
+        xml.writeEndElement();
+    }
+    xml.writeEndElement();
+    xml.writeEndDocument();
+    notFoundFile.close();
+    notFoundsChanged = false;
+}
+
 bool Cache::hasEntries(const QString &cacheId, const QString scraper) {
     QMutexLocker locker(&cacheMutex);
     for (const auto &res : resources) {
@@ -1972,6 +2098,32 @@ bool Cache::hasEntries(const QString &cacheId, const QString scraper) {
     return false;
 }
 
+QSet<QString> Cache::getCacheIdSet(const QString scraper) {
+    // Single pass alternative to many hasEntries() calls
+    QMutexLocker locker(&cacheMutex);
+    QSet<QString> cacheIds;
+    for (const auto &res : resources) {
+        if (scraper.isEmpty() || res.source == scraper) {
+            cacheIds.insert(res.cacheId);
+        }
+    }
+    return cacheIds;
+}
+
+QMap<QString, QString> Cache::getMediaFiles(const QString &cacheId,
+                                            const QString &scraper) {
+    QMutexLocker locker(&cacheMutex);
+    const QStringList types = binTypes();
+    QMap<QString, QString> files;
+    for (const auto &res : resources) {
+        if (res.cacheId == cacheId && res.source == scraper &&
+            types.contains(res.type)) {
+            files.insert(res.type, cacheDir.path() + "/" + res.value);
+        }
+    }
+    return files;
+}
+
 void Cache::fillBlanks(GameEntry &entry, const QString scraper) {
     QMutexLocker locker(&cacheMutex);
     QList<Resource> matchingResources;
@@ -1982,6 +2134,8 @@ void Cache::fillBlanks(GameEntry &entry, const QString scraper) {
             matchingResources.append(resource);
         }
     }
+    // Do not block other threads while reading media files from disk
+    locker.unlock();
 
     for (auto type : txtTypes(false)) {
         QString result = "";
@@ -2027,9 +2181,14 @@ void Cache::fillBlanks(GameEntry &entry, const QString scraper) {
         QByteArray data;
         if (fillType(type, matchingResources, result, source)) {
             QFile f(cacheDir.path() + "/" + result);
-            if (f.open(QIODevice::ReadOnly)) {
-                data = f.readAll();
-                f.close();
+            // Videos are copied file to file, no need to hold them in memory
+            if (type != "video") {
+                IoGuard ioGuard(f.fileName());
+                if (f.open(QIODevice::ReadOnly)) {
+                    IoLimiter::adviseSequential(f);
+                    data = f.readAll();
+                    f.close();
+                }
             }
             if (type == "cover") {
                 entry.coverData = data;
@@ -2046,10 +2205,9 @@ void Cache::fillBlanks(GameEntry &entry, const QString scraper) {
             } else if (type == "texture") {
                 entry.textureData = data;
                 entry.textureSrc = source;
-            } else if (type == "video" && !data.isEmpty()) {
+            } else if (type == "video" && f.size() > 0) {
                 // video, manual and fanrt are not part of artwork.xml resp.
                 // compositor.cpp: set filename here
-                entry.videoData = data;
                 entry.videoSrc = source;
                 QFileInfo info(f);
                 entry.videoFormat = info.suffix();
@@ -34,6 +34,7 @@
 #include <QMap>
 #include <QMutex>
 #include <QObject>
+#include <QSet>
 #include <QSharedPointer>
 #include <QString>
 
@@ -98,8 +99,16 @@ public:
                       QString &output);
     void fillBlanks(GameEntry &entry, const QString scraper = "");
     bool hasEntries(const QString &cacheId, const QString scraper = "");
+    QSet<QString> getCacheIdSet(const QString scraper = "");
+    // Cached media files of a game from one scraper, by resource type
+    QMap<QString, QString> getMediaFiles(const QString &cacheId,
+                                         const QString &scraper);
     void addQuickId(const QFileInfo &info, const QString &cacheId);
     QString getQuickId(const QFileInfo &info);
+    void addNotFound(const QString &cacheId, const QString &scraper,
+                     const QString &searchName);
+    bool isNotFound(const QString &cacheId, const QString &scraper,
+                    const QString &searchName, const int days);
     void merge(Cache &mergeCache, bool overwrite,
                const QString &mergeCacheFolder);
     QList<Resource> getResources();
@@ -108,6 +117,7 @@ private:
     QDir cacheDir;
     QMutex cacheMutex;
     QMutex quickIdMutex;
+    QMutex notFoundMutex;
 
     QMap<QString, QList<QString>> prioMap;
 
@@ -116,6 +126,9 @@ private:
     QList<Resource> resources;
     QMap<QString, QPair<qint64, QString>>
         quickIds; // filePath, timestamp + cacheId for quick lookup
+    QMap<QString, qint64>
+        notFounds; // cacheId, scraper and search name, timestamp of the miss
+    bool notFoundsChanged = false;
 
     int resAtLoad = 0;
 
@@ -140,10 +153,15 @@ private:
     bool hasAlpha(const QImage &image);
     void printStats(bool totals);
     void printCacheEditMenu();
+    void readNotFounds();
+    void writeNotFounds();
 
     inline const QString quickIdFilePath() {
         return cacheDir.path() + "/quickid.xml";
     }
+    inline const QString notFoundFilePath() {
+        return cacheDir.path() + "/notfound.xml";
+    }
     inline const QString dbFilePath() { return cacheDir.path() + "/db.xml"; }
     inline const QString prioFilePath() {
         return cacheDir.path() + "/priorities.xml";
@@ -110,8 +110,9 @@ void Cli::createParser(QCommandLineParser *parser, QString platforms) {
         "'mobygames', 'openretro', 'screenscraper', 'thegamesdb' and "
         "'zxinfo' ('worldofspectrum' and 'wos' are backward compability "
         "aliases)\nScrpaing modules local: 'esgamelist', 'gamebase' and "
-        "'import'\nLeave this option out to enable Skyscraper's gamelist "
-        "generation mode.",
+        "'import'\nSeparate several modules with comma to scrape with all "
+        "of them in one run, e.g. 'screenscraper,thegamesdb'.\nLeave this "
+        "option out to enable Skyscraper's gamelist generation mode.",
         "MODULE", "");
     QCommandLineOption uOption(
         "u",
@@ -237,6 +238,10 @@ void Cli::createParser(QCommandLineParser *parser, QString platforms) {
         "CODE", "en");
     QCommandLineOption verbosityOption(
         "verbosity", "Print more info while scraping. Default: 0", "0-3", "0");
+    QCommandLineOption watchOption(
+        "watch",
+        "Keeps running after the initial run and watches the input folder for "
+        "new or changed files. These are processed as soon as they appear.");
     QCommandLineOption hintOption("hint",
                                   "Show a random 'Tip of the Day' and quit.");
 
@@ -272,6 +277,7 @@ void Cli::createParser(QCommandLineParser *parser, QString platforms) {
     parser->addOption(tOption);
     parser->addOption(uOption);
     parser->addOption(verbosityOption);
+    parser->addOption(watchOption);
     parser->addVersionOption();
     parser->addPositionalArgument("romfile(s)", "Specific ROM(s) to scrape",
                                   "[<romfile> [<romfile> [<romfile> ... ]]]");
@@ -414,6 +420,9 @@ QMap<QString, QString> Cli::getSubCommandOpts(const QString subCmd) {
              "cached resources."},
             {"relative",
              "Forces all gamelist paths to be relative to rom location."},
+            {"retrynotfound",
+             "Searches again for games which were not found by the scraping "
+             "module within the last 'notFoundDays' days."},
             {"skipexistingcovers",
              "When generating gamelists, skip processing covers that already "
              "exist in the media output folder."},
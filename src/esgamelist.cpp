@@ -27,6 +27,16 @@
 
 #include "nametools.h"
 
+#include <QDateTime>
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QPair>
+#include <QStringBuilder>
+#include <QXmlStreamReader>
+
 ESGameList::ESGameList(Settings *config, QSharedPointer<NetManager> manager)
     : AbstractScraper(config, manager, MatchType::MATCH_ONE) {
     baseUrl = config->gameListFolder +
@@ -36,68 +46,104 @@ ESGameList::ESGameList(Settings *config, QSharedPointer<NetManager> manager)
         baseUrl = "import/" + config->platform + "/";
         gameListXml = baseUrl + "gamelist.xml";
     }
-    QDomDocument xmlDoc;
+    games = loadGameIndex(gameListXml);
+}
+
+QSharedPointer<const ESGameList::GameIndex>
+ESGameList::loadGameIndex(const QString &gameListXml) {
+    // All threads share the index of a game list. It is read again once the
+    // file changed, e.g. between the batches of watch mode
+    static QMutex indexMutex;
+    static QHash<QString, QPair<QString, QSharedPointer<const GameIndex>>>
+        indexes;
+    QMutexLocker locker(&indexMutex);
+    QFileInfo info(gameListXml);
+    const QString stamp =
+        QString::number(info.lastModified().toMSecsSinceEpoch()) % "-" %
+        QString::number(info.size());
+    auto cached = indexes.constFind(gameListXml);
+    if (cached != indexes.constEnd() && cached.value().first == stamp) {
+        return cached.value().second;
+    }
+
+    QSharedPointer<GameIndex> index = QSharedPointer<GameIndex>(new GameIndex);
     QFile gameListFile(gameListXml);
     if (gameListFile.open(QIODevice::ReadOnly)) {
-        xmlDoc.setContent(&gameListFile);
+        QXmlStreamReader xml(&gameListFile);
+        while (!xml.atEnd()) {
+            if (xml.readNext() != QXmlStreamReader::StartElement ||
+                xml.name() != QLatin1String("game")) {
+                continue;
+            }
+            GameRecord record;
+            while (xml.readNextStartElement()) {
+                const QString tag = xml.name().toString();
+                const QString text = xml.readElementText(
+                    QXmlStreamReader::IncludeChildElements);
+                // First one wins, as with duplicate <game> entries below
+                if (!record.contains(tag)) {
+                    record.insert(tag, text);
+                }
+            }
+            // Key is the last part of <path>
+            QString fileName = QFileInfo(record.value("path")).fileName();
+            if (!fileName.isEmpty() && !index->contains(fileName)) {
+                index->insert(fileName, record);
+            }
+        }
+        if (xml.hasError()) {
+            qWarning() << "Parsing" << gameListXml << "failed at line"
+                       << xml.lineNumber() << xml.errorString();
+        }
         gameListFile.close();
-        games = xmlDoc.elementsByTagName("game");
     }
+    indexes.insert(gameListXml, qMakePair(stamp, index));
+    return index;
 }
 
 void ESGameList::getSearchResults(QList<GameEntry> &gameEntries,
                                   QString searchName, QString platform) {
-    if (games.isEmpty())
-        return;
+    gameRecord.clear();
 
-    gameNode.clear();
-
-    for (int i = 0; i < games.size(); ++i) {
-        // Find <game> where last part of <path> matches file name
-        QFileInfo info(games.item(i).firstChildElement("path").text());
-        if (info.fileName() == searchName) {
-            gameNode = games.item(i);
-            GameEntry game;
-            game.title = gameNode.firstChildElement("name").text();
-            game.platform = platform;
-            gameEntries.append(game);
-            break;
-        }
+    // Find <game> where last part of <path> matches file name
+    auto it = games->constFind(searchName);
+    if (it != games->constEnd()) {
+        gameRecord = it.value();
+        GameEntry game;
+        game.title = gameRecord.value("name");
+        game.platform = platform;
+        gameEntries.append(game);
     }
 }
 
 void ESGameList::getGameData(GameEntry &game) {
-    if (gameNode.isNull())
+    if (gameRecord.isEmpty())
         return;
 
-    game.releaseDate = gameNode.firstChildElement("releasedate").text();
-    game.publisher = gameNode.firstChildElement("publisher").text();
-    game.developer = gameNode.firstChildElement("developer").text();
-    game.players = gameNode.firstChildElement("players").text();
-    game.rating = gameNode.firstChildElement("rating").text();
-    game.tags = gameNode.firstChildElement("genre").text();
-    game.description = gameNode.firstChildElement("desc").text();
+    game.releaseDate = gameRecord.value("releasedate");
+    game.publisher = gameRecord.value("publisher");
+    game.developer = gameRecord.value("developer");
+    game.players = gameRecord.value("players");
+    game.rating = gameRecord.value("rating");
+    game.tags = gameRecord.value("genre");
+    game.description = gameRecord.value("desc");
     if (config->cacheMarquees) {
-        game.marqueeData =
-            loadBinaryData(gameNode.firstChildElement("marquee").text());
+        game.marqueeData = loadBinaryData(gameRecord.value("marquee"));
     }
     if (config->cacheCovers) {
-        game.coverData =
-            loadBinaryData(gameNode.firstChildElement("thumbnail").text());
+        game.coverData = loadBinaryData(gameRecord.value("thumbnail"));
     }
     if (config->cacheScreenshots) {
-        game.screenshotData =
-            loadBinaryData(gameNode.firstChildElement("image").text());
+        game.screenshotData = loadBinaryData(gameRecord.value("image"));
     }
     if (config->manuals) {
-        game.manualData =
-            loadBinaryData(gameNode.firstChildElement("manual").text());
+        game.manualData = loadBinaryData(gameRecord.value("manual"));
     }
     if (config->videos) {
-        loadVideoData(game, gameNode.firstChildElement("video").text());
+        loadVideoData(game, gameRecord.value("video"));
     }
     if (config->fanart) {
-        loadVideoData(game, gameNode.firstChildElement("fanart").text());
+        loadVideoData(game, gameRecord.value("fanart"));
     }
 }
 
@@ -28,7 +28,8 @@
 
 #include "abstractscraper.h"
 
-#include <QDomDocument>
+#include <QHash>
+#include <QSharedPointer>
 
 class ESGameList : public AbstractScraper {
     Q_OBJECT
@@ -46,8 +47,15 @@ private:
     void loadVideoData(GameEntry &game, const QString fileName);
     QString getAbsoluteFileName(const QString fileName);
 
-    QDomNodeList games;
-    QDomNode gameNode;
+    // Child elements of a <game> by tag name
+    typedef QHash<QString, QString> GameRecord;
+    // File name of <path> to its <game>
+    typedef QHash<QString, GameRecord> GameIndex;
+    static QSharedPointer<const GameIndex>
+    loadGameIndex(const QString &gameListXml);
+
+    QSharedPointer<const GameIndex> games;
+    GameRecord gameRecord;
 };
 
 #endif // ESGAMELIST_H
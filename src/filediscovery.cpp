@@ -0,0 +1,88 @@
+/*
+ *  This file is part of skyscraper.
+ *  Copyright 2025 Gemba @ GitHub
+ *
+ *  skyscraper is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  skyscraper is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with skyscraper; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+ */
+
+#include "filediscovery.h"
+
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QThread>
+
+class DirScanTask : public QRunnable {
+public:
+    DirScanTask(FileDiscovery *discovery, const QString &dirPath,
+                const bool recurse)
+        : discovery(discovery), dirPath(dirPath), recurse(recurse) {}
+    void run() override { discovery->scanDir(dirPath, recurse); }
+
+private:
+    FileDiscovery *discovery;
+    QString dirPath;
+    bool recurse;
+};
+
+FileDiscovery::FileDiscovery(const QString &nameFilter,
+                             const QDir::Filters &filter,
+                             const bool honourIgnoreFiles)
+    : nameFilter(nameFilter), filter(filter),
+      honourIgnoreFiles(honourIgnoreFiles) {
+    // Directory listing is latency bound on network mounts, hence use more
+    // threads than cores
+    pool.setMaxThreadCount(qMax(4, QThread::idealThreadCount() * 2));
+}
+
+QMap<QString, QList<QFileInfo>>
+FileDiscovery::scanSubdirs(const QString &rootDir) {
+    result.clear();
+    // Root folder itself is not part of the scan, only its children
+    startSubdirTasks(rootDir);
+    // Also waits for the tasks that are started from within tasks
+    pool.waitForDone();
+    return result;
+}
+
+void FileDiscovery::startSubdirTasks(const QString &dirPath) {
+    QDir dir(dirPath, "", QDir::Name, QDir::Dirs | QDir::NoDotAndDotDot);
+    for (const auto &subdir : dir.entryInfoList()) {
+        // Same as QDirIterator without FollowSymlinks: a symlinked folder is
+        // listed but not descended into
+        pool.start(new DirScanTask(this, subdir.absoluteFilePath(),
+                                   !subdir.isSymLink()));
+    }
+}
+
+void FileDiscovery::scanDir(const QString &dirPath, const bool recurse) {
+    if (honourIgnoreFiles &&
+        QFileInfo::exists(dirPath + "/.skyscraperignoretree")) {
+        return;
+    }
+    if (recurse) {
+        startSubdirTasks(dirPath);
+    }
+    if (honourIgnoreFiles &&
+        QFileInfo::exists(dirPath + "/.skyscraperignore")) {
+        return;
+    }
+
+    QDir dir(dirPath, nameFilter, QDir::Name, filter);
+    QList<QFileInfo> files = dir.entryInfoList();
+    if (!files.isEmpty()) {
+        QMutexLocker locker(&resultMutex);
+        result.insert(dirPath, files);
+    }
+}
@@ -0,0 +1,54 @@
+/*
+ *  This file is part of skyscraper.
+ *  Copyright 2025 Gemba @ GitHub
+ *
+ *  skyscraper is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  skyscraper is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with skyscraper; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+ */
+
+#ifndef FILEDISCOVERY_H
+#define FILEDISCOVERY_H
+
+#include <QDir>
+#include <QFileInfo>
+#include <QList>
+#include <QMap>
+#include <QMutex>
+#include <QString>
+#include <QThreadPool>
+
+class FileDiscovery {
+public:
+    FileDiscovery(const QString &nameFilter, const QDir::Filters &filter,
+                  const bool honourIgnoreFiles);
+
+    // Walks all subdirectories below rootDir concurrently. Returns the
+    // matching files per subdirectory, ordered by subdirectory path
+    QMap<QString, QList<QFileInfo>> scanSubdirs(const QString &rootDir);
+
+private:
+    friend class DirScanTask;
+    void startSubdirTasks(const QString &dirPath);
+    void scanDir(const QString &dirPath, const bool recurse);
+
+    QString nameFilter;
+    QDir::Filters filter;
+    bool honourIgnoreFiles;
+
+    QThreadPool pool;
+    QMutex resultMutex;
+    QMap<QString, QList<QFileInfo>> result;
+};
+
+#endif // FILEDISCOVERY_H
@@ -19,6 +19,7 @@
 
 #include "gamebase.h"
 
+#include <QDateTime>
 #include <QDebug>
 #include <QFileInfo>
 #include <QStringBuilder>
@@ -37,6 +38,8 @@ GamebaseScraper::GamebaseScraper(Settings *config,
         qCritical() << "Connection with database failed. Terminating.";
         qCritical() << db.lastError();
         reqRemaining = 0;
+    } else {
+        indexReady = prepareIndex();
     }
 
     // supported types:
@@ -105,6 +108,13 @@ static const QMap<QString, QString> SQL_CLAUSES = {
     {"Name", "LOWER(%1) %2 LOWER(:v)"},
     {"CRC", "LOWER(%1) = LOWER(:v)"}};
 
+// Preselect the candidates through the trigram index, the clauses above
+// still decide on them. LIKE on a trigram index is case insensitive
+static const QMap<QString, QString> INDEX_CLAUSES = {
+    {"Filename", "%1 LIKE '%' || :f || '%2.ZIP'"},
+    {"Name", "%1 LIKE :f"},
+    {"CRC", "%1 LIKE :f"}};
+
 static const QRegularExpression GLOB_PATTERN = QRegularExpression(R"(\*|\?)");
 
 void GamebaseScraper::getSearchResults(QList<GameEntry> &gameEntries,
@@ -129,10 +139,21 @@ void GamebaseScraper::getSearchResults(QList<GameEntry> &gameEntries,
             // match PIRATES!_05727_05.zip from gamefile PIRATES!.d64
             clause = clause.arg(searchNameIsFilename ? "%" : "");
         }
+        if (indexReady) {
+            QString indexClause = INDEX_CLAUSES[c].arg(c);
+            if (c == "Filename") {
+                indexClause = indexClause.arg(searchNameIsFilename ? "%" : "");
+            }
+            clause = "GA_Id IN (SELECT rowid FROM gbidx.Search WHERE " %
+                     indexClause % ") AND " % clause;
+        }
 
         QSqlQuery q;
         q.prepare(SQL_QUERY_GAMES.arg(clause).arg(limit));
         q.bindValue(":v", searchName);
+        if (indexReady) {
+            q.bindValue(":f", searchName);
+        }
         q.exec();
         qDebug() << "Executed:" << q.lastQuery();
         qDebug() << "v =" << q.boundValue(":v").toString();
@@ -252,6 +273,56 @@ void GamebaseScraper::getCover(GameEntry &game) {
     q.clear();
 }
 
+bool GamebaseScraper::prepareIndex() {
+    // The index is kept next to the GameBase file and rebuilt when that
+    // changes
+    QFileInfo fi(config->gameBaseFile);
+    const QString indexFile =
+        fi.absolutePath() % "/" % fi.completeBaseName() % ".skyscraper-idx";
+    const QString stamp =
+        QString::number(fi.lastModified().toSecsSinceEpoch()) % "-" %
+        QString::number(fi.size());
+
+    QSqlQuery q;
+    q.prepare("ATTACH DATABASE :file AS gbidx");
+    q.bindValue(":file", indexFile);
+    if (!q.exec()) {
+        qWarning() << "Can't open GameBase index" << indexFile
+                   << q.lastError();
+        return false;
+    }
+    q.exec("CREATE TABLE IF NOT EXISTS gbidx.Meta (Key TEXT PRIMARY KEY, "
+           "Value TEXT)");
+    q.exec("SELECT Value FROM gbidx.Meta WHERE Key = 'source'");
+    if (q.first() && q.value(0).toString() == stamp) {
+        return true;
+    }
+
+    printf("Building search index of GameBase file '%s', just a sec...",
+           config->gameBaseFile.toStdString().c_str());
+    fflush(stdout);
+    db.transaction();
+    q.exec("DROP TABLE IF EXISTS gbidx.Search");
+    // Trigram tokenizer needs SQLite 3.34 or later, without it the search
+    // falls back to scanning the tables
+    if (!q.exec("CREATE VIRTUAL TABLE gbidx.Search USING fts5(Name, "
+                "Filename, CRC, tokenize = 'trigram')") ||
+        !q.exec("INSERT INTO gbidx.Search (rowid, Name, Filename, CRC) "
+                "SELECT GA_Id, Name, Filename, CRC FROM Games")) {
+        qWarning() << "Can't build GameBase index" << q.lastError();
+        db.rollback();
+        printf("\033[1;33m Failed!\033[0m\n\n");
+        return false;
+    }
+    q.prepare("INSERT OR REPLACE INTO gbidx.Meta (Key, Value) VALUES "
+              "('source', :stamp)");
+    q.bindValue(":stamp", stamp);
+    q.exec();
+    db.commit();
+    printf("\033[1;32m Done!\033[0m\n\n");
+    return true;
+}
+
 QByteArray GamebaseScraper::loadImageData(const QString &subFolder,
                                           QString &fileName) {
     QByteArray data;
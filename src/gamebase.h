@@ -40,10 +40,13 @@ private:
     void getGameData(GameEntry &game) override;
     void getCover(GameEntry &game) override;
     QByteArray loadImageData(const QString &subFolder, QString &fileName);
+    bool prepareIndex();
 
     QSqlDatabase db;
 
     bool searchNameIsFilename = false;
+    // Trigram index of names, filenames and CRCs is attached as 'gbidx'
+    bool indexReady = false;
 };
 
 #endif // GAMEBASE_H
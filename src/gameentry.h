@@ -31,6 +31,7 @@
 #include <QList>
 #include <QMap>
 #include <QPair>
+#include <QSet>
 #include <QString>
 
 class GameEntry {
@@ -162,6 +163,16 @@ public:
     QString sqrNotes = "";
     QString parNotes = "";
     QString videoFormat = "";
+    // Streamed video download in the cache folder, moved into place by
+    // Cache::addResources()
+    QString videoTempFile = "";
+    // A video download was cancelled for exceeding 'videoSizeLimit'
+    bool videoSizeExceeded = false;
+    // Media already cached from the scraping module by resource type, set on
+    // refresh so the module can skip downloads of unchanged media
+    QMap<QString, QString> cachedMedia;
+    // Resource types the module found unchanged, they keep their cached file
+    QSet<QString> unchangedMedia;
     QString baseName = "";
     QString absoluteFilePath = "";
     bool found = true;
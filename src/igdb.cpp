@@ -30,8 +30,37 @@
 #include "strtools.h"
 
 #include <QJsonArray>
+#include <QMutex>
 #include <QRandomGenerator>
 #include <QRegularExpression>
+#include <QSet>
+#include <QWaitCondition>
+
+// Fields of a game used by the getters
+static const QStringList GAME_FIELDS = {
+    // clang-format off
+    "age_ratings.organization",
+    "age_ratings.rating_category",
+    "cover.url",
+    "game_modes.slug",
+    "genres.name",
+    "involved_companies.company.name",
+    "involved_companies.developer",
+    "involved_companies.publisher",
+    "release_dates.date",
+    "release_dates.platform",
+    "release_dates.region",
+    "screenshots.url",
+    "summary",
+    "total_rating"
+    // clang-format on
+};
+
+// Search results resolved by prefetch() of any thread, keyed by search name
+static QMutex batchMutex;
+static QWaitCondition batchDone;
+static QHash<QString, QJsonArray> prefetched;
+static QSet<QString> pending;
 
 Igdb::Igdb(Settings *config, QSharedPointer<NetManager> manager)
     : AbstractScraper(config, manager, MatchType::MATCH_MANY) {
@@ -47,13 +76,6 @@ Igdb::Igdb(Settings *config, QSharedPointer<NetManager> manager)
     headers.append(clientIdHeader);
     headers.append(tokenHeader);
 
-    connect(&limitTimer, &QTimer::timeout, &limiter, &QEventLoop::quit);
-    /* 1.1 second request limit set a bit above 1.0 as requested by the good
-     * folks at IGDB. Don't change! It will break the module stability. */
-    limitTimer.setInterval(1100);
-    limitTimer.setSingleShot(false);
-    limitTimer.start();
-
     baseUrl = "https://api.igdb.com/v4";
     searchUrlPre = baseUrl;
 
@@ -69,18 +91,73 @@ Igdb::Igdb(Settings *config, QSharedPointer<NetManager> manager)
     fetchOrder.append(GameEntry::Elem::COVER);
 }
 
-void Igdb::getSearchResults(QList<GameEntry> &gameEntries, QString searchName,
-                            QString platform) {
+void Igdb::prefetch(const QList<QFileInfo> &infos) {
+    QString debug;
+    QStringList names;
+    for (const auto &info : infos) {
+        names.append(getSearchNames(info, debug).first());
+    }
+
+    QMutexLocker locker(&batchMutex);
+    // Another thread may be resolving this file already
+    while (pending.contains(names.first())) {
+        batchDone.wait(&batchMutex);
+    }
+    if (prefetched.contains(names.first())) {
+        return;
+    }
+    QStringList batch;
+    for (const auto &name : names) {
+        if (!prefetched.contains(name) && !pending.contains(name) &&
+            !batch.contains(name)) {
+            batch.append(name);
+        }
+    }
+    if (batch.size() < 2) {
+        return;
+    }
+    for (const auto &name : batch) {
+        pending.insert(name);
+    }
+    locker.unlock();
+
+    // One request with a search per file, each result named by its index
+    QString postData;
+    for (int i = 0; i < batch.size(); ++i) {
+        postData.append(QString("query search \"%1\" { %2 };")
+                            .arg(i)
+                            .arg(searchQuery(batch.at(i))));
+    }
+    qDebug() << baseUrl + "/multiquery/";
+    qDebug() << postData;
+    netComm->request(baseUrl + "/multiquery/", postData, headers);
+    q.exec();
+    data = netComm->getData();
+
+    locker.relock();
+    // Names missing from the answer are left to getSearchResults()
+    const QJsonArray results = QJsonDocument::fromJson(data).array();
+    for (const auto &result : results) {
+        bool ok;
+        int idx = result.toObject()["name"].toString().toInt(&ok);
+        if (ok && idx >= 0 && idx < batch.size()) {
+            prefetched.insert(batch.at(idx),
+                              result.toObject()["result"].toArray());
+        }
+    }
+    for (const auto &name : batch) {
+        pending.remove(name);
+    }
+    batchDone.wakeAll();
+}
 
-    limiter.exec();
-    const QStringList fields = {
-        // clang-format off
-        "game.name",
-        "game.platforms.name",
-        "game.release_dates.date",
-        "game.release_dates.platform"
-        // clang-format on
-    };
+QString Igdb::searchQuery(const QString &searchName) {
+    // Also request the details of each game, so getGameData() needs no
+    // further request
+    QStringList fields = {"game.name", "game.platforms.name"};
+    for (const auto &field : GAME_FIELDS) {
+        fields.append("game." + field);
+    }
 
     // Request list of games but don't allow re-releases ("game.version_parent =
     // null")
@@ -96,35 +173,47 @@ void Igdb::getSearchResults(QList<GameEntry> &gameEntries, QString searchName,
         clause = QString("where game = %1").arg(gameId);
     }
 
-    const QString postData =
-        QString("fields %1; %2 & game.version_parent = null;")
-            .arg(fields.join(","))
-            .arg(clause);
-    qDebug() << baseUrl + "/search/";
-    qDebug() << postData;
-    netComm->request(baseUrl + "/search/", postData, headers);
-    q.exec();
-    data = netComm->getData();
+    return QString("fields %1; %2 & game.version_parent = null;")
+        .arg(fields.join(","))
+        .arg(clause);
+}
 
-    jsonDoc = QJsonDocument::fromJson(data);
-    if (jsonDoc.isEmpty()) {
-        return;
-    }
+void Igdb::getSearchResults(QList<GameEntry> &gameEntries, QString searchName,
+                            QString platform) {
+    batchMutex.lock();
+    bool isPrefetched = prefetched.contains(searchName);
+    QJsonArray jsonGames = prefetched.take(searchName);
+    batchMutex.unlock();
+
+    if (!isPrefetched) {
+        const QString postData = searchQuery(searchName);
+        qDebug() << baseUrl + "/search/";
+        qDebug() << postData;
+        netComm->request(baseUrl + "/search/", postData, headers);
+        q.exec();
+        data = netComm->getData();
+
+        jsonDoc = QJsonDocument::fromJson(data);
+        if (jsonDoc.isEmpty()) {
+            return;
+        }
 
-    if (jsonDoc.object()["message"].toString() == "Too Many Requests") {
-        printf("\033[1;31mThe IGDB requests per second limit has been "
-               "exceeded, can't continue!\033[0m\n");
-        reqRemaining = 0;
-        return;
-    }
+        if (jsonDoc.object()["message"].toString() == "Too Many Requests") {
+            printf("\033[1;31mThe IGDB requests per second limit has been "
+                   "exceeded, can't continue!\033[0m\n");
+            reqRemaining = 0;
+            return;
+        }
 
-    QJsonArray jsonGames = jsonDoc.array();
+        jsonGames = jsonDoc.array();
+    }
 
     for (const auto &jsonGame : jsonGames) {
         GameEntry game;
         const QJsonObject gameObj = jsonGame.toObject()["game"].toObject();
         game.title = gameObj["name"].toString();
         game.id = QString::number(gameObj["id"].toInt());
+        game.miscData = QJsonDocument(gameObj).toJson(QJsonDocument::Compact);
 
         QJsonArray jsonPlatforms = gameObj["platforms"].toArray();
         QJsonArray jsonReleaseDates = gameObj["release_dates"].toArray();
@@ -151,27 +240,14 @@ void Igdb::getSearchResults(QList<GameEntry> &gameEntries, QString searchName,
 }
 
 void Igdb::getGameData(GameEntry &game) {
-    limiter.exec();
-    const QStringList fields = {
-        // clang-format off
-        "age_ratings.organization",
-        "age_ratings.rating_category",
-        "cover.url",
-        "game_modes.slug",
-        "genres.name",
-        "involved_companies.company.name",
-        "involved_companies.developer",
-        "involved_companies.publisher",
-        "release_dates.date",
-        "release_dates.platform",
-        "release_dates.region",
-        "screenshots.url",
-        "summary",
-        "total_rating"
-        // clang-format on
-    };
+    if (!game.miscData.isEmpty()) {
+        jsonObj = QJsonDocument::fromJson(game.miscData).object();
+        populateGameEntry(game);
+        return;
+    }
+
     const QString postData = QString("fields %1; where id = %2;")
-                                 .arg(fields.join(","))
+                                 .arg(GAME_FIELDS.join(","))
                                  .arg(game.id.split(";").first());
     netComm->request(baseUrl + "/games/", postData, headers);
     qDebug() << baseUrl + "/games/";
@@ -388,19 +464,12 @@ void Igdb::getScreenshot(GameEntry &game) {
                               mediaFiles.count() - offset);
     }
     QString mediaUrl = mediaFiles.at(chosen).toObject()["url"].toString();
-
-    QByteArray img = mediaFromJsonRef("screenshots", mediaUrl);
-    if (!img.isEmpty()) {
-        game.screenshotData = img;
-    }
+    queueMedia({sizedMediaUrl("screenshots", mediaUrl)}, game.screenshotData);
 }
 
 void Igdb::getCover(GameEntry &game) {
     QString mediaUrl = jsonObj["cover"].toObject()["url"].toString();
-    QByteArray img = mediaFromJsonRef("cover", mediaUrl);
-    if (!img.isEmpty()) {
-        game.coverData = img;
-    }
+    queueMedia({sizedMediaUrl("cover", mediaUrl)}, game.coverData);
 }
 
 QList<QString> Igdb::getSearchNames(const QFileInfo &info, QString &debug) {
@@ -414,9 +483,15 @@ QList<QString> Igdb::getSearchNames(const QFileInfo &info, QString &debug) {
     return QList<QString>{searchName};
 }
 
-QByteArray Igdb::mediaFromJsonRef(QString gameMedia, QString mediaUrl) {
+QString Igdb::sizedMediaUrl(QString gameMedia, QString mediaUrl) {
     mediaUrl = mediaUrl.replace(QRegularExpression("^//"), "https://");
-    mediaUrl = mediaUrl.replace("/t_thumb/", "/t_1080p/");
+    QString size = "t_1080p";
+    if (gameMedia == "screenshots" && getMaxImageSize() > 0) {
+        // Screenshots are landscape, the 1280 pixels wide 720p variant still
+        // exceeds the cache size. Portrait covers need 1080p for it
+        size = "t_720p";
+    }
+    mediaUrl = mediaUrl.replace("/t_thumb/", "/" + size + "/");
     qDebug() << gameMedia << mediaUrl;
-    return downloadMedia(mediaUrl);
+    return mediaUrl;
 }
@@ -37,15 +37,17 @@ class Igdb : public AbstractScraper {
 
 public:
     Igdb(Settings *config, QSharedPointer<NetManager> manager);
+    // Searches of up to 10 files are sent as one multiquery request
+    int getBatchSize() override { return 10; };
+    void prefetch(const QList<QFileInfo> &infos) override;
 
 private:
-    QTimer limitTimer;
-    QEventLoop limiter;
 
     QList<QPair<QString, QString>> headers;
 
     void getSearchResults(QList<GameEntry> &gameEntries, QString searchName,
                           QString platform) override;
+    QString searchQuery(const QString &searchName);
     void getGameData(GameEntry &game) override;
     void getReleaseDate(GameEntry &game) override;
     void getPlayers(GameEntry &game) override;
@@ -61,7 +63,7 @@ private:
     QList<QString> getSearchNames(const QFileInfo &info,
                                   QString &debug) override;
 
-    QByteArray mediaFromJsonRef(QString gameMedia, QString mediaUrl);
+    QString sizedMediaUrl(QString gameMedia, QString mediaUrl);
     QJsonDocument jsonDoc;
     QJsonObject jsonObj;
 };
@@ -97,6 +97,8 @@ void ImportScraper::getGameData(GameEntry &game) {
 void ImportScraper::runPasses(QList<GameEntry> &gameEntries,
                               const QFileInfo &info, QString &, QString &) {
     data = "";
+    nomPos = 0;
+    nomEnd = -1;
     textualFile = "";
     screenshotFile = "";
     coverFile = "";
@@ -182,9 +184,9 @@ void ImportScraper::getAges(GameEntry &game) {
     if (isXml) {
         game.ages = getElementText(agesPre);
     } else {
-        QByteArray dataOrig = data;
+        int startPos = nomPos;
         AbstractScraper::getAges(game);
-        data = dataOrig;
+        nomPos = startPos;
     }
 }
 
@@ -192,9 +194,9 @@ void ImportScraper::getDescription(GameEntry &game) {
     if (isXml) {
         game.description = getElementText(descriptionPre);
     } else {
-        QByteArray dataOrig = data;
+        int startPos = nomPos;
         AbstractScraper::getDescription(game);
-        data = dataOrig;
+        nomPos = startPos;
     }
 }
 
@@ -202,9 +204,9 @@ void ImportScraper::getDeveloper(GameEntry &game) {
     if (isXml) {
         game.developer = getElementText(developerPre);
     } else {
-        QByteArray dataOrig = data;
+        int startPos = nomPos;
         AbstractScraper::getDeveloper(game);
-        data = dataOrig;
+        nomPos = startPos;
     }
 }
 
@@ -212,9 +214,9 @@ void ImportScraper::getPlayers(GameEntry &game) {
     if (isXml) {
         game.players = getElementText(playersPre);
     } else {
-        QByteArray dataOrig = data;
+        int startPos = nomPos;
         AbstractScraper::getPlayers(game);
-        data = dataOrig;
+        nomPos = startPos;
     }
 }
 
@@ -222,9 +224,9 @@ void ImportScraper::getPublisher(GameEntry &game) {
     if (isXml) {
         game.publisher = getElementText(publisherPre);
     } else {
-        QByteArray dataOrig = data;
+        int startPos = nomPos;
         AbstractScraper::getPublisher(game);
-        data = dataOrig;
+        nomPos = startPos;
     }
 }
 
@@ -236,7 +238,7 @@ void ImportScraper::getRating(GameEntry &game) {
     if (isXml) {
         game.rating = getElementText(ratingPre);
     } else {
-        QByteArray dataOrig = data;
+        int startPos = nomPos;
         for (const auto &nom : ratingPre) {
             if (!checkNom(nom)) {
                 return;
@@ -245,8 +247,8 @@ void ImportScraper::getRating(GameEntry &game) {
         for (const auto &nom : ratingPre) {
             nomNom(nom);
         }
-        game.rating = data.left(data.indexOf(ratingPost.toUtf8()));
-        data = dataOrig;
+        game.rating = getNom(ratingPost);
+        nomPos = startPos;
     }
 
     // check for 0, 0.5, 1, 1.5, ... 5 (star rating)
@@ -277,9 +279,9 @@ void ImportScraper::getReleaseDate(GameEntry &game) {
     if (isXml) {
         game.releaseDate = getElementText(releaseDatePre);
     } else {
-        QByteArray dataOrig = data;
+        int startPos = nomPos;
         AbstractScraper::getReleaseDate(game);
-        data = dataOrig;
+        nomPos = startPos;
     }
 }
 
@@ -287,9 +289,9 @@ void ImportScraper::getTags(GameEntry &game) {
     if (isXml) {
         game.tags = getElementText(tagsPre);
     } else {
-        QByteArray dataOrig = data;
+        int startPos = nomPos;
         AbstractScraper::getTags(game);
-        data = dataOrig;
+        nomPos = startPos;
     }
 }
 
@@ -300,7 +302,7 @@ void ImportScraper::getTitle(GameEntry &game) {
     if (isXml) {
         game.title = getElementText(titlePre);
     } else {
-        QByteArray dataOrig = data;
+        int startPos = nomPos;
         for (const auto &nom : titlePre) {
             if (!checkNom(nom)) {
                 return;
@@ -309,8 +311,8 @@ void ImportScraper::getTitle(GameEntry &game) {
         for (const auto &nom : titlePre) {
             nomNom(nom);
         }
-        game.title = data.left(data.indexOf(titlePost.toUtf8())).simplified();
-        data = dataOrig;
+        game.title = getNom(titlePost).simplified();
+        nomPos = startPos;
     }
 }
 
@@ -334,6 +336,8 @@ void ImportScraper::loadData() {
         QFile f(textualFile);
         if (f.open(QIODevice::ReadOnly)) {
             data = f.readAll();
+            nomPos = 0;
+            nomEnd = -1;
             f.close();
         }
     }
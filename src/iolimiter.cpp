@@ -0,0 +1,138 @@
+/*
+ *  This file is part of skyscraper.
+ *  Copyright 2025 Gemba @ GitHub
+ *
+ *  skyscraper is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  skyscraper is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with skyscraper; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+ */
+
+#include "iolimiter.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QStorageInfo>
+#include <QThread>
+
+#if defined(Q_OS_LINUX)
+#include <fcntl.h>
+#endif
+
+IoLimiter &IoLimiter::get() {
+    static IoLimiter ioLimiter;
+    return ioLimiter;
+}
+
+void IoLimiter::addStorage(const QString &path, const int ioThreads) {
+    QStorageInfo storage(path);
+    if (!storage.isValid()) {
+        return;
+    }
+    QMutexLocker locker(&storageMutex);
+    QString rootPath = storage.rootPath();
+    for (const auto &s : storages) {
+        if (s.first == rootPath) {
+            return;
+        }
+    }
+    int slots = ioThreads > 0 ? ioThreads : getAutoSlots(path);
+    qDebug() << "I/O slots for storage" << rootPath << storage.device()
+             << storage.fileSystemType() << slots;
+    int pos = 0;
+    while (pos < storages.size() &&
+           storages.at(pos).first.length() >= rootPath.length()) {
+        pos++;
+    }
+    storages.insert(pos, qMakePair(rootPath, QSharedPointer<QSemaphore>(
+                                                 new QSemaphore(slots))));
+}
+
+void IoLimiter::adviseSequential(QFile &file) {
+#if defined(Q_OS_LINUX)
+    int fd = file.handle();
+    if (fd != -1) {
+        posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+        posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+    }
+#else
+    Q_UNUSED(file);
+#endif
+}
+
+void IoLimiter::acquire(const QString &path) {
+    QSharedPointer<QSemaphore> semaphore = getSemaphore(path);
+    if (!semaphore.isNull()) {
+        semaphore->acquire();
+    }
+}
+
+void IoLimiter::release(const QString &path) {
+    QSharedPointer<QSemaphore> semaphore = getSemaphore(path);
+    if (!semaphore.isNull()) {
+        semaphore->release();
+    }
+}
+
+QSharedPointer<QSemaphore> IoLimiter::getSemaphore(const QString &path) {
+    QMutexLocker locker(&storageMutex);
+    QString absPath = QFileInfo(path).absoluteFilePath();
+    for (const auto &s : storages) {
+        // Match whole path components only, "/mnt/usb" is not "/mnt/usb2"
+        QString root = s.first;
+        if (!root.endsWith('/')) {
+            root.append('/');
+        }
+        if (absPath == s.first || absPath.startsWith(root)) {
+            return s.second;
+        }
+    }
+    // Unregistered storage is not limited
+    return QSharedPointer<QSemaphore>();
+}
+
+int IoLimiter::getAutoSlots(const QString &path) {
+    QStorageInfo storage(path);
+    QString fsType = QString::fromUtf8(storage.fileSystemType()).toLower();
+    QString device = QString::fromUtf8(storage.device());
+
+    if (fsType.startsWith("nfs") || fsType == "cifs" ||
+        fsType.startsWith("smb") || fsType.startsWith("fuse.sshfs") ||
+        device.startsWith("//")) {
+        // Network storage: latency bound, some requests in flight help
+        return 4;
+    }
+#if defined(Q_OS_LINUX)
+    QString devName = device.section('/', -1);
+    if (devName.startsWith("mmcblk")) {
+        // SD cards suffer most from parallel random access
+        return 1;
+    }
+    if (devName.startsWith("nvme")) {
+        return qMax(4, QThread::idealThreadCount());
+    }
+    // Strip partition number to get to the block device, eg. sda1 -> sda
+    while (!devName.isEmpty() && devName.back().isDigit()) {
+        devName.chop(1);
+    }
+    QFile rotational("/sys/block/" + devName + "/queue/rotational");
+    if (rotational.open(QIODevice::ReadOnly)) {
+        bool isHdd = rotational.readAll().trimmed() == "1";
+        rotational.close();
+        // Rotating disks lose throughput with every extra seek
+        return isHdd ? 2 : 4;
+    }
+#endif
+    return 2;
+}
@@ -0,0 +1,69 @@
+/*
+ *  This file is part of skyscraper.
+ *  Copyright 2025 Gemba @ GitHub
+ *
+ *  skyscraper is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  skyscraper is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with skyscraper; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+ */
+
+#ifndef IOLIMITER_H
+#define IOLIMITER_H
+
+#include <QFile>
+#include <QList>
+#include <QMutex>
+#include <QPair>
+#include <QSemaphore>
+#include <QSharedPointer>
+#include <QString>
+
+// Limits the number of concurrent disk operations per storage device,
+// independent of the number of scraping threads
+class IoLimiter {
+public:
+    static IoLimiter &get();
+
+    // Registers the storage device of path. ioThreads <= 0 auto-tunes the
+    // number of concurrent operations from the device type
+    void addStorage(const QString &path, const int ioThreads);
+    void acquire(const QString &path);
+    void release(const QString &path);
+    // Hints the kernel that file will be read front to back, so readahead
+    // is enlarged and the next blocks are fetched while the current are
+    // being processed
+    static void adviseSequential(QFile &file);
+
+private:
+    IoLimiter() {}
+    int getAutoSlots(const QString &path);
+    QSharedPointer<QSemaphore> getSemaphore(const QString &path);
+
+    QMutex storageMutex;
+    // storage root path to semaphore, longest root path first
+    QList<QPair<QString, QSharedPointer<QSemaphore>>> storages;
+};
+
+// Holds an I/O slot for the storage of path while in scope
+class IoGuard {
+public:
+    IoGuard(const QString &path) : path(path) {
+        IoLimiter::get().acquire(path);
+    }
+    ~IoGuard() { IoLimiter::get().release(path); }
+
+private:
+    QString path;
+};
+
+#endif // IOLIMITER_H
@@ -25,6 +25,11 @@
 
 #include "layer.h"
 
+#include "iolimiter.h"
+
+#include <QBuffer>
+#include <QFile>
+#include <QFileInfo>
 #include <QMap>
 #include <math.h>
 
@@ -206,8 +211,23 @@ bool Layer::save(QString filename) {
     if (canvas.isNull())
         return false;
 
-    if (canvas.save(filename)) {
-        return true;
+    // Encode in memory first, so only the actual write is subject to the I/O
+    // limit
+    QByteArray imageData;
+    QBuffer buffer(&imageData);
+    buffer.open(QIODevice::WriteOnly);
+    QByteArray format = QFileInfo(filename).suffix().toUpper().toLatin1();
+    if (!canvas.save(&buffer, format.isEmpty() ? "PNG" : format.constData())) {
+        return false;
+    }
+    buffer.close();
+
+    IoGuard ioGuard(filename);
+    QFile imageFile(filename);
+    if (imageFile.open(QIODevice::WriteOnly)) {
+        bool written = imageFile.write(imageData) == imageData.size();
+        imageFile.close();
+        return written;
     }
     return false;
 }
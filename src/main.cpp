@@ -56,15 +56,11 @@ void customMessageHandler(QtMsgType type, const QMessageLogContext &,
         txt += QString("DEBUG: %1").arg(msg);
         break;
     case QtWarningMsg:
-        if (msg.contains("NetManager") ||
-            msg.contains("iCCP: known incorrect sRGB profile") ||
+        if (msg.contains("iCCP: known incorrect sRGB profile") ||
             msg.contains("profile matches sRGB but writing iCCP instead") ||
             msg.contains("known incorrect sRGB profile") ||
             msg.contains(
                 "QSqlQuery::value: not positioned on a valid record")) {
-            /* ugly, needs proper fix: */
-            // NetManager "Cannot create children for a parent that is in a
-            // different thread."
             return;
         }
         txt += QString(" WARN: %1").arg(msg);
@@ -109,6 +105,14 @@ BOOL WINAPI ConsoleHandler(DWORD dwType) {
                         "nicely. This can take a few seconds depending "
                         "on how many threads are running...\033[0m\n");
                     x->queue->clearAll();
+                    for (auto &extraQueue : x->extraQueues) {
+                        extraQueue->clearAll();
+                    }
+                    x->watchQuit = true;
+                } else if (x->state == Skyscraper::OpMode::WATCH_IDLE) {
+                    // Watch mode waits for changes, it polls the flag and
+                    // leaves from the event loop
+                    x->watchQuit = true;
                 }
             } else {
                 exit(1);
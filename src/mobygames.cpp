@@ -56,11 +56,6 @@ static inline QMap<QString, QString> mobyRegionMap() {
 
 MobyGames::MobyGames(Settings *config, QSharedPointer<NetManager> manager)
     : AbstractScraper(config, manager, MatchType::MATCH_MANY) {
-    connect(&limitTimer, &QTimer::timeout, &limiter, &QEventLoop::quit);
-    limitTimer.setInterval(5000); // 5 second request limit (Hobbyist API)
-    limitTimer.setSingleShot(false);
-    limitTimer.start();
-
     baseUrl = "https://api.mobygames.com";
 
     searchUrlPre = baseUrl + "/v1/games";
@@ -82,7 +77,6 @@ void MobyGames::getSearchResults(QList<GameEntry> &gameEntries,
     int platformId = getPlatformId(config->platform);
 
     printf("Waiting as advised by MobyGames api restrictions...\n");
-    limiter.exec();
     QString req = QString(searchUrlPre % "?api_key=" % config->password);
     bool isMobyGameId;
     int queryGameId = searchName.toInt(&isMobyGameId);
@@ -143,7 +137,6 @@ void MobyGames::getSearchResults(QList<GameEntry> &gameEntries,
 void MobyGames::getGameData(GameEntry &game) {
     printf("Waiting to get game data... ");
     fflush(stdout);
-    limiter.exec();
     netComm->request(game.url);
     q.exec();
     data = netComm->getData();
@@ -270,7 +263,6 @@ void MobyGames::getRating(GameEntry &game) {
 void MobyGames::getCover(GameEntry &game) {
     printf("Waiting to get cover data... ");
     fflush(stdout);
-    limiter.exec();
     QString req = QString(
         game.url.left(game.url.indexOf("?api_key=")) % "/covers" %
         game.url.mid(game.url.indexOf("?api_key="),
@@ -361,7 +353,6 @@ void MobyGames::getCover(GameEntry &game) {
 void MobyGames::getScreenshot(GameEntry &game) {
     printf("Waiting to get screenshot data... ");
     fflush(stdout);
-    limiter.exec();
     netComm->request(
         game.url.left(game.url.indexOf("?api_key=")) % "/screenshots" %
         game.url.mid(game.url.indexOf("?api_key="),
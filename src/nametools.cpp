@@ -25,6 +25,7 @@
 
 #include "nametools.h"
 
+#include "iolimiter.h"
 #include "strtools.h"
 
 #include <QCryptographicHash>
@@ -379,12 +380,9 @@ QString NameTools::getUniqueNotes(const QString &notes, QChar delim) {
     return "";
 }
 
-QString NameTools::getCacheId(const QFileInfo &info) {
-    QCryptographicHash cacheId(QCryptographicHash::Sha1);
-
+bool NameTools::isCacheIdFromData(const QFileInfo &info) {
     // Use checksum of filename if file is a script or an "unstable" compressed
     // filetype
-    bool cacheIdFromData = true;
     if (info.suffix() == "uae" || info.suffix() == "cue" ||
         info.suffix() == "conf" || info.suffix() == "sh" ||
         info.suffix() == "svm" || info.suffix() == "scummvm" ||
@@ -393,22 +391,30 @@ QString NameTools::getCacheId(const QFileInfo &info) {
         info.suffix() == "ml" || info.suffix() == "bat" ||
         info.suffix() == "au3" || info.suffix() == "po" ||
         info.suffix() == "dsk" || info.suffix() == "nib") {
-        cacheIdFromData = false;
+        return false;
     }
     // If file is larger than 50 MiBs, use filename checksum for cache id for
     // optimization reasons
     if (info.size() > 52428800) {
-        cacheIdFromData = false;
+        return false;
     }
     // If file is empty always do checksum on filename
     if (info.size() == 0) {
-        cacheIdFromData = false;
+        return false;
     }
-    if (cacheIdFromData) {
+    return true;
+}
+
+QString NameTools::getCacheId(const QFileInfo &info) {
+    QCryptographicHash cacheId(QCryptographicHash::Sha1);
+
+    if (isCacheIdFromData(info)) {
+        IoGuard ioGuard(info.absoluteFilePath());
         QFile romFile(info.absoluteFilePath());
         if (romFile.open(QIODevice::ReadOnly)) {
+            IoLimiter::adviseSequential(romFile);
             while (!romFile.atEnd()) {
-                cacheId.addData(romFile.read(1024));
+                cacheId.addData(romFile.read(1024 * 1024));
             }
             romFile.close();
         } else {
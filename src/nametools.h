@@ -47,6 +47,7 @@ public:
     static QString getParNotes(QString baseName);
     static QString getUniqueNotes(const QString &notes, QChar delim);
     static QString getCacheId(const QFileInfo &info);
+    static bool isCacheIdFromData(const QFileInfo &info);
     static QString getNameFromTemplate(const GameEntry &game,
                                        const QString &nameTemplate,
                                        const QString &parenthesesInfo,
@@ -25,21 +25,203 @@
 
 #include "netcomm.h"
 
+#include "ratelimiter.h"
+
+#include <QDateTime>
 #include <QDebug>
+#include <QMap>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QNetworkRequest>
+#include <QRandomGenerator>
 #include <QUrl>
 
+// Identical requests in flight, shared by all threads. Each key maps to the
+// NetComms waiting for the reply of the one that sends it. Waiters remove
+// themselves when they give up or are destroyed, so the pointers are valid
+// as long as the mutex is held
+static QMutex flightMutex;
+static QMap<QString, QList<NetComm *>> flights;
+// The request in flight may still wait for the RateLimiter, so waiters give
+// up later than a stalled request times out
+constexpr int FLIGHTTIMEOUTMS = 60000;
+
 constexpr int MAXSIZE = 100 * 1000 * 1000;
+// Overloaded servers and dropped connections are retried after 1-2, 2-4 and
+// 4-8 seconds
+constexpr int MAXRETRIES = 3;
+constexpr int BACKOFFMS = 2000;
+// Larger responses are media or dumps, not worth keeping
+constexpr int MAXCACHESIZE = 10 * 1000 * 1000;
 
 NetComm::NetComm(QSharedPointer<NetManager> manager) : manager(manager) {
     requestTimer.setSingleShot(true);
     requestTimer.setInterval(30000);
     connect(&requestTimer, &QTimer::timeout, this, &NetComm::requestTimeout);
+    flightTimer.setSingleShot(true);
+    flightTimer.setInterval(FLIGHTTIMEOUTMS);
+    connect(&flightTimer, &QTimer::timeout, this, &NetComm::flightTimeout);
+}
+
+NetComm::~NetComm() {
+    leaveFlight();
+    if (!flightKey.isEmpty()) {
+        // The reply will never arrive, don't leave the waiters hanging
+        data.clear();
+        error = QNetworkReply::OperationCanceledError;
+        contentType.clear();
+        redirUrl.clear();
+        headerPairs.clear();
+        fromCache = false;
+        sizeExceeded = false;
+        shareReply();
+    }
 }
 
 void NetComm::request(QString query, QString postData,
                       QList<QPair<QString, QString>> headers) {
+    lastQuery = query;
+    lastPostData = postData;
+    lastHeaders = headers;
+    retries = 0;
+    leaveFlight();
+    QString method = postData.isNull() ? "GET"
+                     : postData == "HEAD" ? "HEAD"
+                                          : "POST";
+    requestKey = ResponseCache::getKey(
+        query, method, method == "POST" ? postData.toUtf8() : QByteArray());
+    if (joinFlight()) {
+        return;
+    }
+    sendRequest();
+}
+
+bool NetComm::joinFlight() {
+    flightKey = "";
+    // A stream goes to the file of one caller only
+    if (!streamFile.fileName().isEmpty()) {
+        return false;
+    }
+    QMutexLocker locker(&flightMutex);
+    auto it = flights.find(requestKey);
+    if (it != flights.end()) {
+        qDebug() << "Waiting for identical request in flight" << lastQuery;
+        it.value().append(this);
+        waitKey = requestKey;
+        flightTimer.start();
+        return true;
+    }
+    flights.insert(requestKey, QList<NetComm *>());
+    flightKey = requestKey;
+    return false;
+}
+
+void NetComm::leaveFlight() {
+    flightTimer.stop();
+    if (waitKey.isEmpty()) {
+        return;
+    }
+    QMutexLocker locker(&flightMutex);
+    auto it = flights.find(waitKey);
+    if (it != flights.end()) {
+        it.value().removeAll(this);
+    }
+    waitKey = "";
+}
+
+void NetComm::flightTimeout() {
+    qDebug() << "Gave up waiting for identical request" << lastQuery;
+    leaveFlight();
+    sendRequest();
+}
+
+void NetComm::shareReply() {
+    if (flightKey.isEmpty()) {
+        return;
+    }
+    QMutexLocker locker(&flightMutex);
+    const QList<NetComm *> waiting = flights.take(flightKey);
+    // Delivered in the thread of the waiting NetComm. Posted while holding
+    // the mutex, a waiter destroyed meanwhile either left the list before or
+    // discards the call along with its other pending events
+    for (NetComm *other : waiting) {
+        QMetaObject::invokeMethod(
+            other,
+            [other, key = flightKey, data = data, error = error,
+             contentType = contentType, redirUrl = redirUrl,
+             headerPairs = headerPairs, fromCache = fromCache,
+             sizeExceeded = sizeExceeded]() {
+                other->sharedReplyReady(key, data, error, contentType,
+                                        redirUrl, headerPairs, fromCache,
+                                        sizeExceeded);
+            },
+            Qt::QueuedConnection);
+    }
+    flightKey = "";
+}
+
+void NetComm::sharedReplyReady(
+    const QString &key, const QByteArray &data,
+    const QNetworkReply::NetworkError error, const QByteArray &contentType,
+    const QByteArray &redirUrl,
+    const QList<QNetworkReply::RawHeaderPair> &headerPairs,
+    const bool fromCache, const bool sizeExceeded) {
+    // Gave up waiting and sent the request itself meanwhile
+    if (key != waitKey) {
+        return;
+    }
+    flightTimer.stop();
+    waitKey = "";
+    // Nothing of an earlier request of this NetComm applies to the reply
+    timedOut = false;
+    cacheKey = "";
+    fixtureKey = "";
+    this->data = data;
+    this->error = error;
+    this->contentType = contentType;
+    this->redirUrl = redirUrl;
+    this->headerPairs = headerPairs;
+    this->fromCache = fromCache;
+    this->sizeExceeded = sizeExceeded;
+    if (error != QNetworkReply::NoError &&
+        error != QNetworkReply::ContentNotFoundError) {
+        failures++;
+    }
+    emit dataReady();
+}
+
+void NetComm::sendRequest() {
+    const QString &query = lastQuery;
+    const QString &postData = lastPostData;
+    const QList<QPair<QString, QString>> &headers = lastHeaders;
     QUrl url(query);
+
+    fromCache = false;
+    sizeExceeded = false;
+    fixtureKey = "";
+    NetFixtures::Mode fixtureMode = NetFixtures::get().getMode();
+    if (fixtureMode != NetFixtures::OFF) {
+        // Keyed without credentials, so recordings replay for any user
+        QString method = postData.isNull() ? "GET"
+                         : postData == "HEAD" ? "HEAD"
+                                              : "POST";
+        fixtureKey = ResponseCache::getKey(
+            NetFixtures::stripCredentials(query), method,
+            method == "POST" ? postData.toUtf8() : QByteArray());
+        if (fixtureMode != NetFixtures::RECORD) {
+            if (!NetFixtures::get().read(fixtureKey, fixture)) {
+                qDebug() << "No network fixture for" << query;
+                fixture = NetFixtures::Fixture();
+                fixture.error = QNetworkReply::UnknownNetworkError;
+            }
+            int latency = fixtureMode == NetFixtures::REPLAY_TIMED
+                              ? static_cast<int>(fixture.latency)
+                              : 0;
+            QTimer::singleShot(latency, this, &NetComm::fixtureReplyReady);
+            return;
+        }
+    }
+
     QNetworkRequest request(url);
 
     QString ua = "Mozilla/5.0 (X11; Ubuntu; Linux x86_64; rv:74.0) "
@@ -55,6 +237,39 @@ void NetComm::request(QString query, QString postData,
     }
     request.setHeader(QNetworkRequest::UserAgentHeader, ua);
 
+    cacheKey = "";
+    bool stream = !streamFile.fileName().isEmpty();
+    if (cacheTtl > 0 && !stream && postData != "HEAD" &&
+        ResponseCache::get().isEnabled()) {
+        cacheKey = ResponseCache::getKey(
+            query, postData.isNull() ? "GET" : "POST", postData.toUtf8());
+        if (ResponseCache::get().read(cacheKey, cachedEntry)) {
+            qint64 age =
+                QDateTime::currentSecsSinceEpoch() - cachedEntry.timestamp;
+            if (!cacheRevalidate && age >= 0 && age < cacheTtl) {
+                qDebug() << "Response cache hit" << cacheKey;
+                // Callers wait in an event loop for dataReady
+                QTimer::singleShot(0, this, &NetComm::cachedReplyReady);
+                return;
+            }
+            QByteArray eTag = ResponseCache::getHeader(cachedEntry, "ETag");
+            QByteArray lastModified =
+                ResponseCache::getHeader(cachedEntry, "Last-Modified");
+            if (!eTag.isEmpty()) {
+                request.setRawHeader("If-None-Match", eTag);
+            }
+            if (!lastModified.isEmpty()) {
+                request.setRawHeader("If-Modified-Since", lastModified);
+            }
+        } else {
+            cachedEntry = ResponseCache::Entry();
+        }
+    }
+
+    // Only requests which actually hit the server use up the rate limit
+    RateLimiter::get().acquire(url);
+    requestClock.start();
+
     if (postData.isNull()) {
         // GET iff postData is null, as "" is in use for POST w/o postData
         // No body -> no Content-Type
@@ -70,22 +285,252 @@ void NetComm::request(QString query, QString postData,
     connect(reply, &QNetworkReply::finished, this, &NetComm::replyReady);
     connect(reply, &QNetworkReply::downloadProgress, this,
             &NetComm::dataDownloaded);
+    if (stream) {
+        connect(reply, &QNetworkReply::readyRead, this, &NetComm::streamData);
+    }
     requestTimer.start();
 }
 
+void NetComm::setStreamFile(const QString &fileName, const qint64 maxSize) {
+    streamFile.setFileName(fileName);
+    streamMaxSize = maxSize;
+}
+
+bool NetComm::isStreamOk() {
+    int status =
+        reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    // Error pages and redirect bodies stay in memory like any other reply
+    return status >= 200 && status < 300 &&
+           reply->error() == QNetworkReply::NoError;
+}
+
+void NetComm::streamData() {
+    if (!isStreamOk()) {
+        return;
+    }
+    if (!streamFile.isOpen() &&
+        !streamFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        printf("\033[1;31mError writing file: '%s'\033[0m\n",
+               streamFile.fileName().toStdString().c_str());
+        reply->abort();
+        return;
+    }
+    streamFile.write(reply->readAll());
+}
+
+void NetComm::finishStream() {
+    bool ok = error == QNetworkReply::NoError;
+    if (ok && streamFile.isOpen()) {
+        streamFile.write(data);
+        data.clear();
+    }
+    streamFile.close();
+    if (!ok) {
+        streamFile.remove();
+    }
+    // One-shot, the next request is kept in memory again
+    streamFile.setFileName(QString());
+}
+
 void NetComm::replyReady() {
     requestTimer.stop();
     data = reply->readAll();
     error = reply->error();
+    int status =
+        reply->attribute(QNetworkRequest::HttpStatusCodeAttribute).toInt();
+    bool transient = isTransient(status);
+    timedOut = false;
+    if (status == 429 || status == 503) {
+        holdBackOnRetryAfter(reply->url(), reply->rawHeader("Retry-After"));
+    }
+    if (transient) {
+        // Once the host is paused, further retries now are doomed anyway
+        if (!RateLimiter::get().reportFailure(reply->url()) &&
+            retries < MAXRETRIES) {
+            reply->deleteLater();
+            if (streamFile.isOpen()) {
+                streamFile.close();
+                streamFile.remove();
+            }
+            // Exponential backoff with jitter, so the threads hit by the same
+            // overload don't come back all at once
+            int delay = BACKOFFMS << retries;
+            delay = delay / 2 + QRandomGenerator::global()->bounded(delay / 2);
+            retries++;
+            qDebug() << "Retry" << retries << "of" << lastQuery << "in"
+                     << delay << "ms, status" << status << "error" << error;
+            QTimer::singleShot(delay, this, &NetComm::sendRequest);
+            return;
+        }
+    } else if (status > 0) {
+        RateLimiter::get().reportSuccess(reply->url());
+    }
+    QString streamedFile;
+    if (!streamFile.fileName().isEmpty()) {
+        if (error == QNetworkReply::NoError && !isStreamOk()) {
+            // Nothing else than 2xx is wanted on disk
+            error = QNetworkReply::UnknownContentError;
+        }
+        if (error == QNetworkReply::NoError) {
+            streamedFile = streamFile.fileName();
+        }
+        finishStream();
+    }
     contentType = reply->rawHeader("Content-Type");
     redirUrl = reply->rawHeader("Location");
     headerPairs = reply->rawHeaderPairs();
     reply->deleteLater();
+    if (!fixtureKey.isEmpty()) {
+        recordFixture(status, streamedFile);
+    }
+    if (error != QNetworkReply::NoError &&
+        error != QNetworkReply::ContentNotFoundError && status != 304) {
+        failures++;
+    }
+    if (!cacheKey.isEmpty()) {
+        if (status == 304 && cachedEntry.timestamp > 0) {
+            // Not modified, the cached response is good for another ttl
+            cachedEntry.timestamp = QDateTime::currentSecsSinceEpoch();
+            ResponseCache::get().write(cacheKey, cachedEntry);
+            cachedReplyReady();
+            return;
+        }
+        if (isCacheable()) {
+            ResponseCache::Entry entry;
+            entry.timestamp = QDateTime::currentSecsSinceEpoch();
+            entry.error = error;
+            entry.headers = headerPairs;
+            entry.data = data;
+            ResponseCache::get().write(cacheKey, entry);
+        }
+    }
+    shareReply();
+    emit dataReady();
+}
+
+void NetComm::cachedReplyReady() {
+    data = cachedEntry.data;
+    error = static_cast<QNetworkReply::NetworkError>(cachedEntry.error);
+    contentType = ResponseCache::getHeader(cachedEntry, "Content-Type");
+    redirUrl = ResponseCache::getHeader(cachedEntry, "Location");
+    headerPairs = cachedEntry.headers;
+    fromCache = true;
+    shareReply();
+    emit dataReady();
+}
+
+void NetComm::fixtureReplyReady() {
+    data = fixture.data;
+    error = static_cast<QNetworkReply::NetworkError>(fixture.error);
+    contentType = ResponseCache::getHeader(fixture.headers, "Content-Type");
+    redirUrl = ResponseCache::getHeader(fixture.headers, "Location");
+    headerPairs = fixture.headers;
+    if (!streamFile.fileName().isEmpty()) {
+        if (error == QNetworkReply::NoError) {
+            streamFile.open(QIODevice::WriteOnly | QIODevice::Truncate);
+        }
+        finishStream();
+    }
+    shareReply();
     emit dataReady();
 }
 
+void NetComm::recordFixture(const int status, const QString &streamedFile) {
+    NetFixtures::Fixture recorded;
+    recorded.url = NetFixtures::stripCredentials(lastQuery);
+    recorded.status = status;
+    recorded.error = error;
+    recorded.latency = requestClock.elapsed();
+    recorded.headers = headerPairs;
+    recorded.data = data;
+    if (!streamedFile.isEmpty()) {
+        QFile f(streamedFile);
+        if (f.open(QIODevice::ReadOnly)) {
+            recorded.data = f.readAll();
+        }
+    }
+    NetFixtures::get().write(fixtureKey, recorded);
+}
+
+void NetComm::setResponseCache(const int ttl, const bool revalidate) {
+    cacheTtl = ttl;
+    cacheRevalidate = revalidate;
+}
+
+void NetComm::holdBackOnRetryAfter(const QUrl &url,
+                                   const QByteArray &retryAfter) {
+    if (retryAfter.isEmpty()) {
+        return;
+    }
+    // Either delay in seconds or a HTTP date
+    bool isSeconds = false;
+    int seconds = retryAfter.trimmed().toInt(&isSeconds);
+    if (!isSeconds) {
+        QDateTime until =
+            QDateTime::fromString(QString(retryAfter), Qt::RFC2822Date);
+        seconds =
+            until.isValid() ? QDateTime::currentDateTimeUtc().secsTo(until) : 0;
+    }
+    // Don't let a bogus value stall the run
+    RateLimiter::get().pause(url, qMin(seconds, 600));
+}
+
+bool NetComm::isTransient(const int status) {
+    if (status == 429 || status == 502 || status == 503 || status == 504) {
+        return true;
+    }
+    switch (error) {
+    case QNetworkReply::RemoteHostClosedError:
+    case QNetworkReply::ConnectionRefusedError:
+    case QNetworkReply::TimeoutError:
+    case QNetworkReply::TemporaryNetworkFailureError:
+    case QNetworkReply::NetworkSessionFailedError:
+        return true;
+    case QNetworkReply::OperationCanceledError:
+        // Cancelled by requestTimeout(), not because of the size limit
+        return timedOut && !sizeExceeded;
+    default:
+        return false;
+    }
+}
+
+bool NetComm::isCacheable() {
+    if (data.size() > MAXCACHESIZE) {
+        return false;
+    }
+    // A "not found" is as valuable as a found game, it saves the same
+    // request on the next run
+    if (error == QNetworkReply::ContentNotFoundError) {
+        return true;
+    }
+    if (error != QNetworkReply::NoError) {
+        return false;
+    }
+    if (!redirUrl.isEmpty()) {
+        return true;
+    }
+    // Only API responses, media is kept in the resource cache already
+    QByteArray type = contentType.toLower();
+    return !data.isEmpty() &&
+           (type.startsWith("text/") || type.contains("json") ||
+            type.contains("xml") || type.contains("javascript"));
+}
+
 QByteArray NetComm::getData() { return data; }
 
+int NetComm::getFailures() { return failures; }
+
+bool NetComm::isFromCache() { return fromCache; }
+
+bool NetComm::isSizeExceeded() { return sizeExceeded; }
+
+void NetComm::dropCachedReply() {
+    if (cacheTtl > 0 && !requestKey.isEmpty()) {
+        qDebug() << "Dropping cached reply" << requestKey;
+        ResponseCache::get().remove(requestKey);
+    }
+}
+
 QString NetComm::getHeaderValue(const QString headerKey) {
     for (const auto &h : headerPairs) {
         if (h.first == headerKey.toUtf8()) {
@@ -157,10 +602,17 @@ QByteArray NetComm::getContentType() { return contentType; }
 
 QByteArray NetComm::getRedirUrl() { return redirUrl; }
 
-void NetComm::dataDownloaded(qint64 bytesReceived, qint64) {
-    if (bytesReceived > MAXSIZE) {
-        printf("Retrieved data size exceeded maximum of 100 MB, cancelling "
-               "network request...\n");
+void NetComm::dataDownloaded(qint64 bytesReceived, qint64 bytesTotal) {
+    // Large files may take a while, only a stalled transfer times out
+    requestTimer.start();
+    bool stream = !streamFile.fileName().isEmpty();
+    qint64 maxSize = stream ? streamMaxSize : MAXSIZE;
+    // The announced size cancels a too large download right away
+    if (qMax(bytesReceived, bytesTotal) > maxSize) {
+        printf("Retrieved data size exceeds maximum of %d MB, cancelling "
+               "network request...\n",
+               static_cast<int>(maxSize / 1000 / 1000));
+        sizeExceeded = true;
         reply->abort();
     }
 }
@@ -168,5 +620,6 @@ void NetComm::dataDownloaded(qint64 bytesReceived, qint64) {
 void NetComm::requestTimeout() {
     printf("\033[1;33mRequest timed out, server might be busy / "
            "overloaded...\033[0m\n");
+    timedOut = true;
     reply->abort();
 }
@@ -26,8 +26,12 @@
 #ifndef NETCOMM_H
 #define NETCOMM_H
 
+#include "netfixtures.h"
 #include "netmanager.h"
+#include "responsecache.h"
 
+#include <QElapsedTimer>
+#include <QFile>
 #include <QNetworkReply>
 #include <QTimer>
 
@@ -36,6 +40,7 @@ class NetComm : public QObject {
 
 public:
     NetComm(QSharedPointer<NetManager> manager);
+    ~NetComm();
     void request(QString query, QString postData = QString(),
                  QList<QPair<QString, QString>> headers =
                      QList<QPair<QString, QString>>());
@@ -44,11 +49,34 @@ public:
     QByteArray getContentType();
     QByteArray getRedirUrl();
     QString getHeaderValue(const QString headerKey);
+    // Number of requests that failed for other reasons than "not found"
+    int getFailures();
+    // True if the last reply came from the response cache, including replies
+    // the server confirmed as unchanged. Its data may be outdated
+    bool isFromCache();
+    // True if the last reply was cancelled for exceeding the size limit
+    bool isSizeExceeded();
+    // Removes the last reply from the response cache. For replies the module
+    // can't use (error pages, failed API calls), so they are not served again
+    void dropCachedReply();
+    // Serves text responses (search results, game info) from the on-disk
+    // response cache for ttl seconds, older entries are revalidated with the
+    // server. With revalidate every entry is considered stale
+    void setResponseCache(const int ttl, const bool revalidate = false);
+    // Writes the body of the next reply to fileName as it arrives instead of
+    // keeping it in memory. Replies larger than maxSize are cancelled, on any
+    // error the file is removed
+    void setStreamFile(const QString &fileName, const qint64 maxSize);
 
 private slots:
     void replyReady();
-    void dataDownloaded(qint64 bytesReceived, qint64);
+    void cachedReplyReady();
+    void fixtureReplyReady();
+    void dataDownloaded(qint64 bytesReceived, qint64 bytesTotal);
+    void streamData();
     void requestTimeout();
+    void flightTimeout();
+    void sendRequest();
 
 signals:
     void dataReady();
@@ -62,6 +90,45 @@ private:
     QByteArray redirUrl;
     QNetworkReply *reply;
     QList<QNetworkReply::RawHeaderPair> headerPairs;
+
+    QString lastQuery;
+    QString lastPostData;
+    QList<QPair<QString, QString>> lastHeaders;
+    int retries = 0;
+    QElapsedTimer requestClock;
+    QString requestKey;
+    QString flightKey;
+    QString waitKey;
+    QTimer flightTimer;
+    bool joinFlight();
+    void leaveFlight();
+    void shareReply();
+    void sharedReplyReady(
+        const QString &key, const QByteArray &data,
+        const QNetworkReply::NetworkError error, const QByteArray &contentType,
+        const QByteArray &redirUrl,
+        const QList<QNetworkReply::RawHeaderPair> &headerPairs,
+        const bool fromCache, const bool sizeExceeded);
+    QString fixtureKey;
+    NetFixtures::Fixture fixture;
+    void recordFixture(const int status, const QString &streamedFile);
+    bool timedOut = false;
+    bool sizeExceeded = false;
+    bool isTransient(const int status);
+
+    int failures = 0;
+    int cacheTtl = 0;
+    bool cacheRevalidate = false;
+    QString cacheKey;
+    ResponseCache::Entry cachedEntry;
+    bool fromCache = false;
+    QFile streamFile;
+    qint64 streamMaxSize = 0;
+    bool isStreamOk();
+    void finishStream();
+
+    bool isCacheable();
+    void holdBackOnRetryAfter(const QUrl &url, const QByteArray &retryAfter);
 };
 
 #endif // NETCOMM_H
@@ -0,0 +1,112 @@
+/*
+ *  This file is part of skyscraper.
+ *  Copyright 2025 Gemba @ GitHub
+ *
+ *  skyscraper is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  skyscraper is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with skyscraper; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+ */
+
+#include "netfixtures.h"
+
+#include <QDataStream>
+#include <QDebug>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QStringList>
+#include <QUrl>
+#include <QUrlQuery>
+
+// Increase when the layout of the fixture files changes
+constexpr quint32 FIXTUREVERSION = 1;
+
+NetFixtures &NetFixtures::get() {
+    static NetFixtures netFixtures;
+    return netFixtures;
+}
+
+void NetFixtures::setMode(const Mode mode, const QString &folder) {
+    QMutexLocker locker(&modeMutex);
+    if (mode != OFF && (folder.isEmpty() || !QDir(folder).mkpath("."))) {
+        printf("\033[1;33mCouldn't use network fixture folder '%s', "
+               "continuing without it.\033[0m\n",
+               folder.toStdString().c_str());
+        this->mode = OFF;
+        return;
+    }
+    this->mode = mode;
+    this->folder = folder;
+}
+
+NetFixtures::Mode NetFixtures::getMode() {
+    QMutexLocker locker(&modeMutex);
+    return mode;
+}
+
+bool NetFixtures::read(const QString &key, Fixture &fixture) {
+    QFile fixtureFile(getPath(key));
+    if (!fixtureFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QDataStream in(&fixtureFile);
+    in.setVersion(QDataStream::Qt_5_9);
+    quint32 version = 0;
+    in >> version;
+    if (version != FIXTUREVERSION) {
+        return false;
+    }
+    in >> fixture.url >> fixture.status >> fixture.error >> fixture.latency >>
+        fixture.headers >> fixture.data;
+    return in.status() == QDataStream::Ok;
+}
+
+void NetFixtures::write(const QString &key, const Fixture &fixture) {
+    QString path = getPath(key);
+    if (path.isEmpty() || !QDir().mkpath(QFileInfo(path).absolutePath())) {
+        return;
+    }
+    QSaveFile fixtureFile(path);
+    if (!fixtureFile.open(QIODevice::WriteOnly)) {
+        qDebug() << "Couldn't write network fixture" << path;
+        return;
+    }
+    QDataStream out(&fixtureFile);
+    out.setVersion(QDataStream::Qt_5_9);
+    out << FIXTUREVERSION << fixture.url << fixture.status << fixture.error
+        << fixture.latency << fixture.headers << fixture.data;
+    fixtureFile.commit();
+}
+
+QString NetFixtures::stripCredentials(const QString &url) {
+    static const QStringList credentials = {
+        "devid",   "devpassword", "ssid",      "sspassword",
+        "apikey",  "api_key",     "client_id", "client_secret"};
+    QUrl strippedUrl(url);
+    QUrlQuery query(strippedUrl);
+    for (const auto &key : credentials) {
+        query.removeAllQueryItems(key);
+    }
+    strippedUrl.setQuery(query);
+    return strippedUrl.toString();
+}
+
+QString NetFixtures::getPath(const QString &key) {
+    QMutexLocker locker(&modeMutex);
+    if (folder.isEmpty()) {
+        return QString();
+    }
+    return folder + "/" + key.left(2) + "/" + key;
+}
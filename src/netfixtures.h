@@ -0,0 +1,65 @@
+/*
+ *  This file is part of skyscraper.
+ *  Copyright 2025 Gemba @ GitHub
+ *
+ *  skyscraper is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  skyscraper is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with skyscraper; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+ */
+
+#ifndef NETFIXTURES_H
+#define NETFIXTURES_H
+
+#include <QByteArray>
+#include <QList>
+#include <QMutex>
+#include <QPair>
+#include <QString>
+
+// Records the network traffic of a run and serves it back on later runs, for
+// benchmarks and tests of the scraping modules without network access or
+// spending request quota. Fixtures are keyed like the response cache
+class NetFixtures {
+public:
+    enum Mode { OFF, RECORD, REPLAY, REPLAY_TIMED };
+
+    struct Fixture {
+        QString url;
+        int status = 0;
+        int error = 0;
+        // Milliseconds from sending the request to the complete reply
+        qint64 latency = 0;
+        QList<QPair<QByteArray, QByteArray>> headers;
+        QByteArray data;
+    };
+
+    static NetFixtures &get();
+
+    void setMode(const Mode mode, const QString &folder);
+    Mode getMode();
+    bool read(const QString &key, Fixture &fixture);
+    void write(const QString &key, const Fixture &fixture);
+    // Url without user and developer credentials, fixtures are meant to be
+    // shared
+    static QString stripCredentials(const QString &url);
+
+private:
+    NetFixtures() {}
+    QString getPath(const QString &key);
+
+    QMutex modeMutex;
+    Mode mode = OFF;
+    QString folder;
+};
+
+#endif // NETFIXTURES_H
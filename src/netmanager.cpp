@@ -25,22 +25,89 @@
 
 #include "netmanager.h"
 
+#include <QElapsedTimer>
 #include <QNetworkRequest>
+#include <QSharedPointer>
+#if QT_CONFIG(ssl)
+#include <QSslConfiguration>
+#endif
+
+QMutex NetManager::statsMutex;
+NetManager::Stats NetManager::stats;
 
 NetManager::NetManager() {}
 
-QNetworkReply *NetManager::getRequest(const QNetworkRequest &request) {
-    QMutexLocker locker(&requestMutex);
-    return get(request);
+QNetworkReply *NetManager::getRequest(QNetworkRequest request) {
+    prepare(request);
+    return track(get(request));
 }
 
-QNetworkReply *NetManager::headRequest(const QNetworkRequest &request) {
-    QMutexLocker locker(&requestMutex);
-    return head(request);
+QNetworkReply *NetManager::headRequest(QNetworkRequest request) {
+    prepare(request);
+    return track(head(request));
 }
 
-QNetworkReply *NetManager::postRequest(const QNetworkRequest &request,
+QNetworkReply *NetManager::postRequest(QNetworkRequest request,
                                        const QByteArray &data) {
-    QMutexLocker locker(&requestMutex);
-    return post(request, data);
+    prepare(request);
+    return track(post(request, data));
+}
+
+void NetManager::prepare(QNetworkRequest &request) {
+#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
+    // Qt 6 does this by default, servers without HTTP/2 get HTTP/1.1
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+    request.setAttribute(QNetworkRequest::Http2AllowedAttribute, true);
+#else
+    request.setAttribute(QNetworkRequest::HTTP2AllowedAttribute, true);
+#endif
+#endif
+#if QT_CONFIG(ssl)
+    // Resume TLS sessions when a new connection to the same host is needed
+    QSslConfiguration ssl = request.sslConfiguration();
+    ssl.setSslOption(QSsl::SslOptionDisableSessionPersistence, false);
+    request.setSslConfiguration(ssl);
+#endif
+}
+
+QNetworkReply *NetManager::track(QNetworkReply *reply) {
+    struct Timing {
+        QElapsedTimer clock;
+        qint64 firstByteMs = -1;
+        bool handshake = false;
+    };
+    QSharedPointer<Timing> timing(new Timing);
+    timing->clock.start();
+    connect(reply, &QNetworkReply::metaDataChanged, reply, [timing]() {
+        if (timing->firstByteMs < 0) {
+            timing->firstByteMs = timing->clock.elapsed();
+        }
+    });
+#if QT_CONFIG(ssl)
+    connect(reply, &QNetworkReply::encrypted, reply,
+            [timing]() { timing->handshake = true; });
+#endif
+    connect(reply, &QNetworkReply::finished, reply, [timing, reply]() {
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+        bool http2 =
+            reply->attribute(QNetworkRequest::Http2WasUsedAttribute).toBool();
+#else
+        bool http2 =
+            reply->attribute(QNetworkRequest::HTTP2WasUsedAttribute).toBool();
+#endif
+        qint64 totalMs = timing->clock.elapsed();
+        QMutexLocker locker(&statsMutex);
+        stats.requests++;
+        stats.handshakes += timing->handshake ? 1 : 0;
+        stats.http2 += http2 ? 1 : 0;
+        stats.firstByteMs +=
+            timing->firstByteMs < 0 ? totalMs : timing->firstByteMs;
+        stats.totalMs += totalMs;
+    });
+    return reply;
+}
+
+NetManager::Stats NetManager::getStats() {
+    QMutexLocker locker(&statsMutex);
+    return stats;
 }
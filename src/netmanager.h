@@ -30,17 +30,34 @@
 #include <QNetworkAccessManager>
 #include <QNetworkReply>
 
+// One instance per thread: A QNetworkAccessManager must only be used from the
+// thread it lives in. Connections are kept alive and reused per instance.
 class NetManager : public QNetworkAccessManager {
     Q_OBJECT
 
 public:
     NetManager();
-    QNetworkReply *getRequest(const QNetworkRequest &request);
-    QNetworkReply *headRequest(const QNetworkRequest &request);
-    QNetworkReply *postRequest(const QNetworkRequest &request,
+    QNetworkReply *getRequest(QNetworkRequest request);
+    QNetworkReply *headRequest(QNetworkRequest request);
+    QNetworkReply *postRequest(QNetworkRequest request,
                                const QByteArray &data);
 
+    struct Stats {
+        int requests = 0;
+        // TLS handshakes, each one is a connection that was not reused
+        int handshakes = 0;
+        int http2 = 0;
+        qint64 firstByteMs = 0;
+        qint64 totalMs = 0;
+    };
+    // Timings of all requests sent over the network by all threads
+    static Stats getStats();
+
 private:
-    QMutex requestMutex;
+    void prepare(QNetworkRequest &request);
+    QNetworkReply *track(QNetworkReply *reply);
+
+    static QMutex statsMutex;
+    static Stats stats;
 };
 #endif // NETMANAGER_H
@@ -114,41 +114,45 @@ void OpenRetro::getSearchResults(QList<GameEntry> &gameEntries,
         q.exec();
     }
     data = netComm->getData();
+    nomPos = 0;
+    nomEnd = -1;
 
     if (data.isEmpty())
         return;
 
     if (data.contains("Error: 500 Internal Server Error") ||
-        data.contains("Error: 404 Not Found"))
+        data.contains("Error: 404 Not Found")) {
+        // Served as a regular page, don't keep it in the response cache
+        netComm->dropCachedReply();
         return;
+    }
 
     if (hasWhdlUuid) {
-        QByteArray tempData = data;
+        int startPos = nomPos;
         nomNom("<td style='width: 180px; color: black;'>game_name</td>");
         nomNom("<td style='color: black;'><div>");
         // Remove AGA, we already add this automatically in
         // StrTools::addSqrBrackets
-        game.title = data.left(data.indexOf("</div></td>"))
+        game.title = getNom("</div></td>")
                          .replace("[AGA]", "")
                          .replace("[CD32]", "")
                          .replace("[CDTV]", "")
                          .simplified();
-        data = tempData;
+        nomPos = startPos;
         game.platform = platform;
         // Check if title is empty. Some games exist but have no data, not even
         // a name. We don't want those results
         if (!game.title.isEmpty())
             gameEntries.append(game);
     } else {
-        while (data.indexOf(searchResultPre.toUtf8()) != -1) {
+        while (checkNom(searchResultPre)) {
             nomNom(searchResultPre);
 
             // Digest until url
             for (const auto &nom : urlPre) {
                 nomNom(nom);
             }
-            game.url = baseUrl % "/" %
-                       data.left(data.indexOf(urlPost.toUtf8())) % "/edit";
+            game.url = baseUrl % "/" % getNom(urlPost) % "/edit";
 
             // Digest until title
             for (const auto &nom : titlePre) {
@@ -156,16 +160,13 @@ void OpenRetro::getSearchResults(QList<GameEntry> &gameEntries,
             }
             // Remove AGA, we already add this automatically in
             // StrTools::addSqrBrackets
-            game.title = data.left(data.indexOf(titlePost.toUtf8()))
-                             .replace("[AGA]", "")
-                             .simplified();
+            game.title = getNom(titlePost).replace("[AGA]", "").simplified();
 
             // Digest until platform
             for (const auto &nom : platformPre) {
                 nomNom(nom);
             }
-            game.platform = data.left(data.indexOf(platformPost.toUtf8()))
-                                .replace("&nbsp;", " ");
+            game.platform = getNom(platformPost).replace("&nbsp;", " ");
 
             if (platformMatch(game.platform, platform)) {
                 gameEntries.append(game);
@@ -179,10 +180,12 @@ void OpenRetro::getGameData(GameEntry &game) {
         netComm->request(game.url);
         q.exec();
         data = netComm->getData();
+        nomPos = 0;
+        nomEnd = -1;
     }
 
-    // Remove all the variants so we don't choose between their screenshots
-    data = data.left(data.indexOf("</table></div><div id='"));
+    // Leave out all the variants so we don't choose between their screenshots
+    nomEnd = data.indexOf("</table></div><div id='", nomPos);
     populateGameEntry(game);
 }
 
@@ -190,13 +193,13 @@ void OpenRetro::getDescription(GameEntry &game) {
     if (descriptionPre.isEmpty()) {
         return;
     }
-    QByteArray tempData = data;
+    int startPos = nomPos;
 
-    if (data.indexOf(descriptionPre.at(0).toUtf8()) != -1) {
+    if (checkNom(descriptionPre.at(0))) {
         // If description
         nomNom(descriptionPre.at(0));
         nomNom(descriptionPre.at(1));
-    } else if (data.indexOf(descriptionPre.at(2).toUtf8()) != -1) {
+    } else if (checkNom(descriptionPre.at(2))) {
         // If __long_description
         nomNom(descriptionPre.at(2));
         nomNom(descriptionPre.at(3));
@@ -204,11 +207,10 @@ void OpenRetro::getDescription(GameEntry &game) {
         return;
     }
 
-    game.description = data.left(data.indexOf(descriptionPost.toUtf8()))
-                           .replace("&lt;", "<")
-                           .replace("&gt;", ">");
-    // Revert data back to pre-description
-    data = tempData;
+    game.description =
+        getNom(descriptionPost).replace("&lt;", "<").replace("&gt;", ">");
+    // Revert cursor back to pre-description
+    nomPos = startPos;
 
     // Remove all html tags within description
     game.description = StrTools::stripHtmlTags(game.description);
@@ -225,10 +227,10 @@ void OpenRetro::getTags(GameEntry &game) {
     }
     QString tags = "";
     QString tagBegin = "<a href=\"/browse/";
-    while (data.indexOf(tagBegin.toUtf8()) != -1) {
+    while (checkNom(tagBegin)) {
         nomNom(tagBegin);
         nomNom("\">");
-        tags.append(data.left(data.indexOf("</a>")) % ", ");
+        tags.append(getNom("</a>") % ", ");
     }
     if (!tags.isEmpty()) {
         tags.chop(2); // Remove last ", "
@@ -242,6 +244,8 @@ void OpenRetro::getRating(GameEntry &game) {
     netComm->request(game.url);
     q.exec();
     data = netComm->getData();
+    nomPos = 0;
+    nomEnd = -1;
 
     bool ratingDecimal = true;
 
@@ -259,7 +263,7 @@ void OpenRetro::getRating(GameEntry &game) {
     }
 
     bool toDoubleOk = false;
-    game.rating = data.left(data.indexOf(ratingPost.toUtf8()));
+    game.rating = getNom(ratingPost);
     qDebug() << "game.rating" << game.rating;
     qDebug() << "ratingDecimal" << ratingDecimal;
 
@@ -303,8 +307,7 @@ void OpenRetro::getCover(GameEntry &game) {
         nomNom(nom);
     }
     QString coverUrl =
-        data.left(data.indexOf(coverPost.toUtf8())).replace("&amp;", "&") %
-        QString("?s=512");
+        getNom(coverPost).replace("&amp;", "&") % QString("?s=512");
     if (coverUrl.left(4) != "http") {
         coverUrl.prepend(baseUrl % (coverUrl.left(1) == "/" ? "" : "/"));
     }
@@ -324,8 +327,7 @@ void OpenRetro::getMarquee(GameEntry &game) {
         nomNom(nom);
     }
     QString marqueeUrl =
-        data.left(data.indexOf(marqueePost.toUtf8())).replace("&amp;", "&") %
-        QString("?s=512");
+        getNom(marqueePost).replace("&amp;", "&") % QString("?s=512");
     if (marqueeUrl.left(4) != "http") {
         marqueeUrl.prepend(baseUrl % (marqueeUrl.left(1) == "/" ? "" : "/"));
     }
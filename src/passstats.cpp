@@ -0,0 +1,135 @@
+/*
+ *  This file is part of skyscraper.
+ *  Copyright 2025 Gemba @ GitHub
+ *
+ *  skyscraper is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  skyscraper is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with skyscraper; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+ */
+
+#include "passstats.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QStringBuilder>
+
+#include <algorithm>
+
+// Games found per platform and module before the variants get reordered
+constexpr int MINPASSHITS = 10;
+// Tries of the first variant without any match before it is moved back
+constexpr int MINFIRSTTRIES = 20;
+
+PassStats &PassStats::get() {
+    static PassStats passStats;
+    return passStats;
+}
+
+void PassStats::load(const QString &fileName) {
+    QMutexLocker locker(&statsMutex);
+    this->fileName = fileName;
+    stats.clear();
+    changed = false;
+    QFile statsFile(fileName);
+    if (!statsFile.open(QIODevice::ReadOnly)) {
+        return;
+    }
+    const QJsonObject jsonObj =
+        QJsonDocument::fromJson(statsFile.readAll()).object();
+    statsFile.close();
+    for (auto it = jsonObj.constBegin(); it != jsonObj.constEnd(); ++it) {
+        // Skips the counts by pass index of earlier versions
+        const QJsonObject variants = it.value().toObject();
+        for (auto v = variants.constBegin(); v != variants.constEnd(); ++v) {
+            const QJsonArray counts = v.value().toArray();
+            Counts c;
+            c.tries = counts.at(0).toInt();
+            c.hits = counts.at(1).toInt();
+            stats[it.key()].insert(v.key(), c);
+        }
+    }
+}
+
+void PassStats::save() {
+    QMutexLocker locker(&statsMutex);
+    if (!changed || fileName.isEmpty()) {
+        return;
+    }
+    QJsonObject jsonObj;
+    for (auto it = stats.constBegin(); it != stats.constEnd(); ++it) {
+        QJsonObject variants;
+        for (auto v = it.value().constBegin(); v != it.value().constEnd();
+             ++v) {
+            variants.insert(v.key(), QJsonArray({v.value().tries,
+                                                 v.value().hits}));
+        }
+        jsonObj.insert(it.key(), variants);
+    }
+    QSaveFile statsFile(fileName);
+    if (!statsFile.open(QIODevice::WriteOnly)) {
+        qDebug() << "Couldn't write search pass stats" << fileName;
+        return;
+    }
+    statsFile.write(QJsonDocument(jsonObj).toJson(QJsonDocument::Compact));
+    if (statsFile.commit()) {
+        changed = false;
+    }
+}
+
+QList<int> PassStats::getOrder(const QString &platform, const QString &scraper,
+                               const QStringList &variants,
+                               const bool pinFirst) {
+    QList<int> order;
+    for (int i = 0; i < variants.size(); ++i) {
+        order.append(i);
+    }
+    QMutexLocker locker(&statsMutex);
+    const QMap<QString, Counts> counts = stats.value(platform % "/" % scraper);
+    int total = 0;
+    for (const auto &c : counts) {
+        total += c.hits;
+    }
+    if (variants.size() < 2 || total < MINPASSHITS) {
+        return order;
+    }
+    auto rate = [&counts, &variants](int idx) {
+        const Counts c = counts.value(variants.at(idx));
+        return c.tries > 0 ? static_cast<double>(c.hits) / c.tries : 0.0;
+    };
+    const Counts first = counts.value(variants.first());
+    bool keepFirst =
+        pinFirst || first.hits > 0 || first.tries < MINFIRSTTRIES;
+    // Stable, variants with the same rate keep the module's order
+    std::stable_sort(order.begin() + (keepFirst ? 1 : 0), order.end(),
+                     [&rate](int a, int b) { return rate(a) > rate(b); });
+    return order;
+}
+
+void PassStats::addTry(const QString &platform, const QString &scraper,
+                       const QString &variant) {
+    QMutexLocker locker(&statsMutex);
+    stats[platform % "/" % scraper][variant].tries++;
+    changed = true;
+}
+
+void PassStats::addHit(const QString &platform, const QString &scraper,
+                       const QString &variant) {
+    QMutexLocker locker(&statsMutex);
+    stats[platform % "/" % scraper][variant].hits++;
+    changed = true;
+}
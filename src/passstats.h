@@ -0,0 +1,68 @@
+/*
+ *  This file is part of skyscraper.
+ *  Copyright 2025 Gemba @ GitHub
+ *
+ *  skyscraper is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  skyscraper is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with skyscraper; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+ */
+
+#ifndef PASSSTATS_H
+#define PASSSTATS_H
+
+#include <QList>
+#include <QMap>
+#include <QMutex>
+#include <QString>
+#include <QStringList>
+
+// Counts how often each search name variant of a scraping module (e.g. the
+// exact name, the name without subtitle) was tried and led to an accepted
+// match, per platform and module. The variants are then tried in the order
+// most likely to succeed, which saves the requests of variants that rarely
+// find anything. The counts are kept across runs
+class PassStats {
+public:
+    static PassStats &get();
+
+    // Reads the counts from a file, which is also used by save()
+    void load(const QString &fileName);
+    void save();
+    // Returns the indexes into variants, most successful first. The first
+    // variant is the most specific one, it stays first if pinFirst is set or
+    // unless it never matched. The order is kept until enough games have
+    // been found to tell
+    QList<int> getOrder(const QString &platform, const QString &scraper,
+                        const QStringList &variants, const bool pinFirst);
+    void addTry(const QString &platform, const QString &scraper,
+                const QString &variant);
+    // Only for matches accepted by the search match threshold
+    void addHit(const QString &platform, const QString &scraper,
+                const QString &variant);
+
+private:
+    PassStats() {}
+
+    struct Counts {
+        int tries = 0;
+        int hits = 0;
+    };
+
+    QMutex statsMutex;
+    QString fileName;
+    // Counts per variant by "<platform>/<scraper>"
+    QMap<QString, QMap<QString, Counts>> stats;
+    bool changed = false;
+};
+
+#endif // PASSSTATS_H
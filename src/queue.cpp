@@ -25,7 +25,13 @@
 
 #include "queue.h"
 
-#include <QRegularExpression>
+#include <QMutexLocker>
+#include <QSet>
+#include <algorithm>
+
+#if defined(Q_OS_UNIX)
+#include <sys/stat.h>
+#endif
 
 Queue::Queue() {}
 
@@ -45,6 +51,11 @@ QFileInfo Queue::takeEntry() {
     return info;
 }
 
+QList<QFileInfo> Queue::peekEntries(int count) {
+    QMutexLocker locker(&queueMutex);
+    return mid(0, count);
+}
+
 void Queue::clearAll() {
     queueMutex.lock();
     clear();
@@ -52,23 +63,15 @@ void Queue::clearAll() {
 }
 
 void Queue::filterFiles(const QString &patterns, const bool &include) {
-    QList<QString> regExpPatterns = getRegExpPatterns(patterns);
+    // Compile all patterns into one alternation once instead of building a
+    // new regular expression per pattern and file
+    const QRegularExpression matcher = getGlobMatcher(patterns);
 
     queueMutex.lock();
     QMutableListIterator<QFileInfo> it(*this);
     while (it.hasNext()) {
-        QFileInfo info = it.next();
-        bool match = false;
-        for (const auto &regExpPattern : regExpPatterns) {
-            if (QRegularExpression(regExpPattern)
-                    .match(info.fileName())
-                    .hasMatch()) {
-                match = true;
-            }
-        }
-        if (match && !include) {
-            it.remove();
-        } else if (!match && include) {
+        bool match = matcher.match(it.next().fileName()).hasMatch();
+        if (match != include) {
             it.remove();
         }
     }
@@ -76,34 +79,120 @@ void Queue::filterFiles(const QString &patterns, const bool &include) {
 }
 
 void Queue::removeFiles(const QList<QString> &files) {
+    QSet<QString> fileSet;
+    fileSet.reserve(files.size());
+    for (const auto &file : files) {
+        fileSet.insert(file);
+    }
+
     queueMutex.lock();
     QMutableListIterator<QFileInfo> it(*this);
     while (it.hasNext()) {
-        QFileInfo info = it.next();
-        for (const auto &file : files) {
-            if (info.absoluteFilePath() == file) {
-                it.remove();
-                break;
-            }
+        if (fileSet.contains(it.next().absoluteFilePath())) {
+            it.remove();
+        }
+    }
+    queueMutex.unlock();
+}
+
+void Queue::orderByCost(const QHash<QString, EntryCost> &costs) {
+    queueMutex.lock();
+    entryCosts = costs;
+    QList<QFileInfo> buckets[COSTS];
+    for (const auto &info : *this) {
+        buckets[costs.value(info.absoluteFilePath(), NETWORK)].append(info);
+    }
+    clear();
+    // Cached entries go first as they only need local processing. Then
+    // alternate between network bound entries and entries which need their
+    // rom file hashed first, so disk and network are busy at the same time.
+    // Each class keeps its order, after orderByLocality() the rom files to
+    // hash are still read folder by folder and in inode order
+    append(buckets[CACHED]);
+    const QList<QFileInfo> &network = buckets[NETWORK];
+    const QList<QFileInfo> &hashing = buckets[HASHING];
+    for (int i = 0; i < qMax(network.size(), hashing.size()); ++i) {
+        if (i < hashing.size()) {
+            append(hashing.at(i));
+        }
+        if (i < network.size()) {
+            append(network.at(i));
         }
     }
+    // Refreshing known entries comes last, so a request quota is spent on
+    // new entries first
+    append(buckets[REFRESH]);
     queueMutex.unlock();
 }
 
-QList<QString> Queue::getRegExpPatterns(QString patterns) {
+void Queue::orderByLocality() {
+    struct LocalityKey {
+        QString dir;
+        quint64 inode;
+        QFileInfo info;
+    };
+    queueMutex.lock();
+    const QList<QFileInfo> entries = *this;
+    queueMutex.unlock();
+    // stat() every file without holding up the workers taking entries
+    QList<LocalityKey> keys;
+    keys.reserve(entries.size());
+    for (const auto &info : entries) {
+        keys.append({info.absolutePath(), getInode(info), info});
+    }
+    // Stable sort keeps the name order for entries on filesystems without
+    // meaningful inode numbers
+    std::stable_sort(keys.begin(), keys.end(),
+                     [](const LocalityKey &a, const LocalityKey &b) {
+                         if (a.dir != b.dir) {
+                             return a.dir < b.dir;
+                         }
+                         return a.inode < b.inode;
+                     });
+    queueMutex.lock();
+    if (size() != entries.size()) {
+        // Taken from or added to meanwhile, keep the order as is
+        queueMutex.unlock();
+        return;
+    }
+    clear();
+    for (const auto &key : keys) {
+        append(key.info);
+    }
+    queueMutex.unlock();
+}
+
+Queue::EntryCost Queue::getCost(const QString &absoluteFilePath) {
+    QMutexLocker locker(&queueMutex);
+    return entryCosts.value(absoluteFilePath, NETWORK);
+}
+
+QRegularExpression Queue::getGlobMatcher(QString patterns) {
     patterns.replace("\\,", "###COMMA###");
     patterns.replace(",", ";");
 
-    QList<QString> regExpPatterns;
+    QStringList regExpPatterns;
 
     for (auto regExpPattern : patterns.split(";")) {
         regExpPattern.replace("###COMMA###", ",");
         regExpPattern = QRegularExpression::escape(regExpPattern);
         regExpPattern.replace("\\*", ".*");
-        regExpPattern.prepend("^");
-        regExpPattern.append("$");
         regExpPatterns.append(regExpPattern);
     }
 
-    return regExpPatterns;
+    QRegularExpression matcher("^(?:" + regExpPatterns.join("|") + ")$");
+    matcher.optimize();
+    return matcher;
+}
+
+quint64 Queue::getInode(const QFileInfo &info) {
+#if defined(Q_OS_UNIX)
+    struct stat st;
+    if (stat(info.absoluteFilePath().toLocal8Bit().constData(), &st) == 0) {
+        return st.st_ino;
+    }
+#else
+    Q_UNUSED(info);
+#endif
+    return 0;
 }
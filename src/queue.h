@@ -27,21 +27,37 @@
 #define QUEUE_H
 
 #include <QFileInfo>
+#include <QHash>
 #include <QList>
 #include <QMutex>
+#include <QRegularExpression>
 
 class Queue : public QList<QFileInfo> {
 public:
+    // Expected processing cost of an entry, cheapest first. REFRESH are
+    // entries cached already but looked up again on a refresh run
+    enum EntryCost { CACHED, NETWORK, HASHING, REFRESH, COSTS };
+
     Queue();
     bool hasEntry();
     QFileInfo takeEntry();
+    // Returns up to count entries next in line, without taking them
+    QList<QFileInfo> peekEntries(int count);
     void clearAll();
     void filterFiles(const QString &patterns, const bool &include = false);
     void removeFiles(const QList<QString> &files);
+    void orderByCost(const QHash<QString, EntryCost> &costs);
+    // Groups entries by directory and orders them by their on-disk position
+    // (inode) within, so concurrent workers read neighbouring files. Call it
+    // before orderByCost(), which keeps this order within each cost class
+    void orderByLocality();
+    EntryCost getCost(const QString &absoluteFilePath);
 
 private:
     QMutex queueMutex;
-    QList<QString> getRegExpPatterns(QString patterns);
+    QHash<QString, EntryCost> entryCosts;
+    QRegularExpression getGlobMatcher(QString patterns);
+    quint64 getInode(const QFileInfo &info);
 };
 
 #endif // QUEUE_H
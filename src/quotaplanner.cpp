@@ -0,0 +1,80 @@
+/*
+ *  This file is part of skyscraper.
+ *  Copyright 2025 Gemba @ GitHub
+ *
+ *  skyscraper is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  skyscraper is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with skyscraper; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+ */
+
+#include "quotaplanner.h"
+
+#include <QDebug>
+#include <QHash>
+#include <QMutexLocker>
+#include <QSharedPointer>
+
+QuotaPlanner &QuotaPlanner::get(const QString &scraper) {
+    static QMutex plannersMutex;
+    static QHash<QString, QSharedPointer<QuotaPlanner>> planners;
+    QMutexLocker locker(&plannersMutex);
+    if (!planners.contains(scraper)) {
+        planners.insert(scraper,
+                        QSharedPointer<QuotaPlanner>(new QuotaPlanner));
+    }
+    return *planners.value(scraper);
+}
+
+void QuotaPlanner::reportRemaining(const int remaining) {
+    QMutexLocker locker(&quotaMutex);
+    if (remaining < 0) {
+        return;
+    }
+    if (this->remaining < 0) {
+        this->remaining = remaining;
+        return;
+    }
+    // Each report follows one game, the drop since the last report is what
+    // that game cost. Stale reports of other threads are ignored
+    if (remaining < this->remaining) {
+        costPerGame = 0.8 * costPerGame + 0.2 * (this->remaining - remaining);
+        this->remaining = remaining;
+        qDebug() << "Quota remaining" << remaining << "per game"
+                 << costPerGame;
+    }
+}
+
+bool QuotaPlanner::hasBudget(const int threads) {
+    QMutexLocker locker(&quotaMutex);
+    if (remaining < 0) {
+        return true;
+    }
+    if (remaining >= costPerGame * qMax(threads, 1)) {
+        return true;
+    }
+    exhausted = true;
+    return false;
+}
+
+int QuotaPlanner::getGamesLeft() {
+    QMutexLocker locker(&quotaMutex);
+    if (remaining < 0) {
+        return -1;
+    }
+    return static_cast<int>(remaining / costPerGame);
+}
+
+bool QuotaPlanner::isExhausted() {
+    QMutexLocker locker(&quotaMutex);
+    return exhausted;
+}
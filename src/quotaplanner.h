@@ -0,0 +1,55 @@
+/*
+ *  This file is part of skyscraper.
+ *  Copyright 2025 Gemba @ GitHub
+ *
+ *  skyscraper is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  skyscraper is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with skyscraper; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+ */
+
+#ifndef QUOTAPLANNER_H
+#define QUOTAPLANNER_H
+
+#include <QMutex>
+#include <QString>
+
+// Plans the use of a request quota (e.g. ScreenScraper's daily requests)
+// across all scraping threads. The requests a game costs are learned from
+// the remaining quota the module reports after each game
+class QuotaPlanner {
+public:
+    // One planner per scraping module, their quotas are independent
+    static QuotaPlanner &get(const QString &scraper);
+
+    // Remaining quota as reported by the scraping module after a game
+    void reportRemaining(const int remaining);
+    // False once the remaining quota no longer covers one more game per
+    // thread. The rest is kept for the games still in progress, so they
+    // complete with all their media
+    bool hasBudget(const int threads);
+    // Estimated number of games the remaining quota covers, -1 if unknown
+    int getGamesLeft();
+    // True if a thread has been stopped because of the quota
+    bool isExhausted();
+
+private:
+    QuotaPlanner() {}
+
+    QMutex quotaMutex;
+    int remaining = -1;
+    // Average requests per game, at least the search
+    double costPerGame = 1.0;
+    bool exhausted = false;
+};
+
+#endif // QUOTAPLANNER_H
@@ -0,0 +1,128 @@
+/*
+ *  This file is part of skyscraper.
+ *  Copyright 2025 Gemba @ GitHub
+ *
+ *  skyscraper is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  skyscraper is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with skyscraper; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+ */
+
+#include "ratelimiter.h"
+
+#include <QDebug>
+#include <QEventLoop>
+#include <QMutexLocker>
+#include <QTimer>
+
+constexpr int BREAKERFAILURES = 5;
+constexpr int BREAKERMINSECS = 30;
+constexpr int BREAKERMAXSECS = 300;
+
+RateLimiter &RateLimiter::get() {
+    static RateLimiter rateLimiter;
+    return rateLimiter;
+}
+
+void RateLimiter::setInterval(const QString &domain, const int interval) {
+    QMutexLocker locker(&bucketMutex);
+    if (interval <= 0) {
+        buckets.remove(domain);
+        return;
+    }
+    qDebug() << "Request interval for" << domain << interval << "ms";
+    buckets[domain].interval = interval;
+}
+
+void RateLimiter::acquire(const QUrl &url) {
+    qint64 wait = 0;
+    {
+        QMutexLocker locker(&bucketMutex);
+        QString domain = getDomain(url.host());
+        if (domain.isEmpty()) {
+            return;
+        }
+        // Reserve the next token before waiting, so threads get their turn
+        // in order and never two of them the same token
+        Bucket &bucket = buckets[domain];
+        qint64 now = clock.elapsed();
+        qint64 token = qMax(now, bucket.nextToken);
+        bucket.nextToken = token + bucket.interval;
+        wait = token - now;
+    }
+    if (wait > 0) {
+        QEventLoop waitLoop;
+        QTimer::singleShot(static_cast<int>(wait), &waitLoop,
+                           &QEventLoop::quit);
+        waitLoop.exec();
+    }
+}
+
+void RateLimiter::pause(const QUrl &url, const int seconds) {
+    QMutexLocker locker(&bucketMutex);
+    if (seconds <= 0 || url.host().isEmpty()) {
+        return;
+    }
+    QString domain = getDomain(url.host());
+    if (domain.isEmpty()) {
+        // Not rate limited otherwise, only hold back for the given time
+        domain = url.host();
+    }
+    printf("\033[1;33mServer '%s' asked to wait %d seconds before the next "
+           "request...\033[0m\n",
+           url.host().toStdString().c_str(), seconds);
+    Bucket &bucket = buckets[domain];
+    bucket.nextToken =
+        qMax(bucket.nextToken, clock.elapsed() + (qint64)seconds * 1000);
+}
+
+bool RateLimiter::reportFailure(const QUrl &url) {
+    QMutexLocker locker(&bucketMutex);
+    if (url.host().isEmpty()) {
+        return false;
+    }
+    QString domain = getDomain(url.host());
+    if (domain.isEmpty()) {
+        domain = url.host();
+    }
+    Bucket &bucket = buckets[domain];
+    if (++bucket.failures < BREAKERFAILURES) {
+        return false;
+    }
+    bucket.failures = 0;
+    bucket.breakerSeconds =
+        qBound(BREAKERMINSECS, bucket.breakerSeconds * 2, BREAKERMAXSECS);
+    printf("\033[1;33mServer '%s' seems to be overloaded, pausing requests "
+           "for %d seconds...\033[0m\n",
+           url.host().toStdString().c_str(), bucket.breakerSeconds);
+    bucket.nextToken = qMax(bucket.nextToken,
+                            clock.elapsed() + bucket.breakerSeconds * 1000LL);
+    return true;
+}
+
+void RateLimiter::reportSuccess(const QUrl &url) {
+    QMutexLocker locker(&bucketMutex);
+    QString domain = getDomain(url.host());
+    if (!domain.isEmpty()) {
+        buckets[domain].failures = 0;
+        buckets[domain].breakerSeconds = 0;
+    }
+}
+
+QString RateLimiter::getDomain(const QString &host) {
+    for (auto it = buckets.constBegin(); it != buckets.constEnd(); ++it) {
+        if (host == it.key() || host.endsWith("." + it.key())) {
+            return it.key();
+        }
+    }
+    return QString();
+}
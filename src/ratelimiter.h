@@ -0,0 +1,66 @@
+/*
+ *  This file is part of skyscraper.
+ *  Copyright 2025 Gemba @ GitHub
+ *
+ *  skyscraper is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  skyscraper is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with skyscraper; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+ */
+
+#ifndef RATELIMITER_H
+#define RATELIMITER_H
+
+#include <QElapsedTimer>
+#include <QMap>
+#include <QMutex>
+#include <QString>
+#include <QUrl>
+
+// Paces the requests to rate limited APIs across all scraping threads. Each
+// domain has a token bucket of size one which is refilled every interval
+class RateLimiter {
+public:
+    static RateLimiter &get();
+
+    // Allows one request per interval milliseconds to domain and its
+    // subdomains. An interval <= 0 removes the limit
+    void setInterval(const QString &domain, const int interval);
+    // Blocks the calling thread until a request to url may be sent. Waiting
+    // threads are served in the order they called
+    void acquire(const QUrl &url);
+    // Holds back all requests to the domain of url, e.g. for a Retry-After
+    void pause(const QUrl &url, const int seconds);
+    // Circuit breaker: Too many overload failures in a row pause the host
+    // for all threads, twice as long each time it stays unavailable. Returns
+    // true if the host has just been paused
+    bool reportFailure(const QUrl &url);
+    void reportSuccess(const QUrl &url);
+
+private:
+    RateLimiter() { clock.start(); }
+    QString getDomain(const QString &host);
+
+    struct Bucket {
+        qint64 interval = 0;
+        // Point in time (clock) the next token becomes available
+        qint64 nextToken = 0;
+        int failures = 0;
+        int breakerSeconds = 0;
+    };
+
+    QMutex bucketMutex;
+    QMap<QString, Bucket> buckets;
+    QElapsedTimer clock;
+};
+
+#endif // RATELIMITER_H
@@ -0,0 +1,195 @@
+/*
+ *  This file is part of skyscraper.
+ *  Copyright 2025 Gemba @ GitHub
+ *
+ *  skyscraper is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  skyscraper is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with skyscraper; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+ */
+
+#include "responsecache.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QDebug>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QMutexLocker>
+#include <QSaveFile>
+#include <QStringList>
+#include <QUrl>
+#include <QUrlQuery>
+#include <algorithm>
+
+// Increase when the layout of the entry files changes
+constexpr quint32 ENTRYVERSION = 1;
+
+ResponseCache &ResponseCache::get() {
+    static ResponseCache responseCache;
+    return responseCache;
+}
+
+void ResponseCache::setFolder(const QString &folder) {
+    QMutexLocker locker(&folderMutex);
+    if (!folder.isEmpty() && !QDir(folder).mkpath(".")) {
+        printf("\033[1;33mCouldn't create response cache folder '%s', "
+               "continuing without it.\033[0m\n",
+               folder.toStdString().c_str());
+        this->folder = "";
+        return;
+    }
+    this->folder = folder;
+}
+
+bool ResponseCache::isEnabled() {
+    QMutexLocker locker(&folderMutex);
+    return !folder.isEmpty();
+}
+
+bool ResponseCache::read(const QString &key, Entry &entry) {
+    QFile entryFile(getPath(key));
+    if (!entryFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QDataStream in(&entryFile);
+    in.setVersion(QDataStream::Qt_5_9);
+    quint32 version = 0;
+    in >> version;
+    if (version != ENTRYVERSION) {
+        return false;
+    }
+    in >> entry.timestamp >> entry.error >> entry.headers >> entry.data;
+    return in.status() == QDataStream::Ok;
+}
+
+void ResponseCache::write(const QString &key, const Entry &entry) {
+    QString path = getPath(key);
+    if (path.isEmpty() || !QDir().mkpath(QFileInfo(path).absolutePath())) {
+        return;
+    }
+    // Other threads may read the same entry, replace it atomically
+    QSaveFile entryFile(path);
+    if (!entryFile.open(QIODevice::WriteOnly)) {
+        qDebug() << "Couldn't write response cache entry" << path;
+        return;
+    }
+    QDataStream out(&entryFile);
+    out.setVersion(QDataStream::Qt_5_9);
+    out << ENTRYVERSION << entry.timestamp << entry.error << entry.headers
+        << entry.data;
+    entryFile.commit();
+}
+
+void ResponseCache::remove(const QString &key) {
+    QString path = getPath(key);
+    if (!path.isEmpty()) {
+        QFile::remove(path);
+    }
+}
+
+int ResponseCache::purgeExpired(const qint64 ttl) {
+    QString cacheFolder;
+    {
+        QMutexLocker locker(&folderMutex);
+        cacheFolder = folder;
+    }
+    if (cacheFolder.isEmpty() || ttl <= 0) {
+        return 0;
+    }
+    int removed = 0;
+    QDateTime now = QDateTime::currentDateTime();
+    QDirIterator it(cacheFolder, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        it.next();
+        // Every write and revalidation replaces the file, its modification
+        // time is close to the entry timestamp. Only read the old ones
+        qint64 age = it.fileInfo().lastModified().secsTo(now);
+        if (age < ttl) {
+            continue;
+        }
+        Entry entry;
+        bool keep = false;
+        if (age < 2 * ttl && read(it.fileName(), entry)) {
+            keep = !getHeader(entry, "ETag").isEmpty() ||
+                   !getHeader(entry, "Last-Modified").isEmpty();
+        }
+        if (!keep && QFile::remove(it.filePath())) {
+            removed++;
+        }
+    }
+    qDebug() << "Purged" << removed << "expired response cache entries";
+    return removed;
+}
+
+QString ResponseCache::getKey(const QString &url, const QString &method,
+                              const QByteArray &body) {
+    // Normalise the url so equivalent requests share one entry: lowercase
+    // scheme and host, no default port, no fragment, sorted query items
+    QUrl normUrl(url);
+    normUrl.setScheme(normUrl.scheme().toLower());
+    normUrl.setHost(normUrl.host().toLower());
+    if ((normUrl.scheme() == "https" && normUrl.port() == 443) ||
+        (normUrl.scheme() == "http" && normUrl.port() == 80)) {
+        normUrl.setPort(-1);
+    }
+    normUrl.setFragment(QString());
+    QList<QPair<QString, QString>> items =
+        QUrlQuery(normUrl).queryItems(QUrl::FullyEncoded);
+    std::stable_sort(items.begin(), items.end(),
+                     [](const QPair<QString, QString> &a,
+                        const QPair<QString, QString> &b) {
+                         return a.first < b.first;
+                     });
+    QStringList queryItems;
+    for (const auto &item : items) {
+        queryItems.append(item.first + "=" + item.second);
+    }
+    normUrl.setQuery(QString());
+
+    QCryptographicHash key(QCryptographicHash::Sha1);
+    key.addData(method.toUpper().toUtf8());
+    key.addData(" ");
+    key.addData(normUrl.toEncoded());
+    key.addData("?");
+    key.addData(queryItems.join("&").toUtf8());
+    key.addData("\n");
+    key.addData(body.trimmed());
+    return key.result().toHex();
+}
+
+QByteArray ResponseCache::getHeader(const Entry &entry,
+                                    const QByteArray &name) {
+    return getHeader(entry.headers, name);
+}
+
+QByteArray
+ResponseCache::getHeader(const QList<QPair<QByteArray, QByteArray>> &headers,
+                         const QByteArray &name) {
+    for (const auto &h : headers) {
+        if (h.first.toLower() == name.toLower()) {
+            return h.second;
+        }
+    }
+    return QByteArray();
+}
+
+QString ResponseCache::getPath(const QString &key) {
+    QMutexLocker locker(&folderMutex);
+    if (folder.isEmpty()) {
+        return QString();
+    }
+    // Two level layout to keep the folders reasonably small
+    return folder + "/" + key.left(2) + "/" + key;
+}
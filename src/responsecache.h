@@ -0,0 +1,69 @@
+/*
+ *  This file is part of skyscraper.
+ *  Copyright 2025 Gemba @ GitHub
+ *
+ *  skyscraper is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  skyscraper is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with skyscraper; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+ */
+
+#ifndef RESPONSECACHE_H
+#define RESPONSECACHE_H
+
+#include <QByteArray>
+#include <QList>
+#include <QMutex>
+#include <QPair>
+#include <QString>
+
+// On-disk cache of API responses, shared by all NetComm instances. Each
+// response is stored in its own file named after the request key
+class ResponseCache {
+public:
+    struct Entry {
+        // Seconds since epoch when the response was received or revalidated
+        qint64 timestamp = 0;
+        int error = 0;
+        QList<QPair<QByteArray, QByteArray>> headers;
+        QByteArray data;
+    };
+
+    static ResponseCache &get();
+
+    // Enables the cache, an empty folder disables it
+    void setFolder(const QString &folder);
+    bool isEnabled();
+    bool read(const QString &key, Entry &entry);
+    void write(const QString &key, const Entry &entry);
+    void remove(const QString &key);
+    // Removes entries older than ttl seconds which the server can't
+    // revalidate, and all entries older than twice the ttl. Returns the
+    // number of removed entries
+    int purgeExpired(const qint64 ttl);
+
+    static QString getKey(const QString &url, const QString &method,
+                          const QByteArray &body);
+    static QByteArray getHeader(const Entry &entry, const QByteArray &name);
+    static QByteArray
+    getHeader(const QList<QPair<QByteArray, QByteArray>> &headers,
+              const QByteArray &name);
+
+private:
+    ResponseCache() {}
+    QString getPath(const QString &key);
+
+    QMutex folderMutex;
+    QString folder;
+};
+
+#endif // RESPONSECACHE_H
@@ -34,10 +34,13 @@
 #include "gameentry.h"
 #include "igdb.h"
 #include "importscraper.h"
+#include "iolimiter.h"
 #include "localscraper.h"
 #include "mobygames.h"
 #include "nametools.h"
 #include "openretro.h"
+#include "passstats.h"
+#include "quotaplanner.h"
 #include "screenscraper.h"
 #include "settings.h"
 #include "strtools.h"
@@ -54,15 +57,16 @@
 constexpr int UNDEF_YEAR = -1;
 
 ScraperWorker::ScraperWorker(QSharedPointer<Queue> queue,
-                             QSharedPointer<Cache> cache,
-                             QSharedPointer<NetManager> manager,
-                             Settings config, QString threadId)
-    : config(config), cache(cache), manager(manager), queue(queue),
-      threadId(threadId) {}
+                             QSharedPointer<Cache> cache, Settings config,
+                             QString threadId)
+    : config(config), cache(cache), queue(queue), threadId(threadId) {}
 
 ScraperWorker::~ScraperWorker() {}
 
 void ScraperWorker::run() {
+    // Created in the worker thread, requests of different threads don't wait
+    // for each other
+    manager = QSharedPointer<NetManager>(new NetManager());
     bool cacheScraper = false;
     if (config.scraper == "openretro") {
         scraper = new OpenRetro(&config, manager);
@@ -148,6 +152,17 @@ void ScraperWorker::run() {
         QList<GameEntry> gameEntries;
 
         bool fromCache = false;
+        // Remembered misses are only kept for the online scraping modules
+        QString missName =
+            config.searchName.isEmpty() ? compareTitle : config.searchName;
+        bool rememberMiss = !cacheScraper && config.scraper != "esgamelist" &&
+                            config.scraper != "gamebase" &&
+                            config.scraper != "import" && !config.interactive;
+        bool knownMiss = rememberMiss && !config.retryNotFound &&
+                         !config.refresh &&
+                         cache->isNotFound(cacheId, config.scraper, missName,
+                                           config.notFoundDays);
+        bool reliableMiss = false;
         if (cacheScraper && cache->hasEntries(cacheId)) {
             fromCache = true;
             GameEntry cachedGame;
@@ -188,9 +203,22 @@ void ScraperWorker::run() {
                     cachedGame.platform = config.platform;
                 }
                 gameEntries.append(cachedGame);
+            } else if (knownMiss) {
+                debug.append("Not found by '" + config.scraper +
+                             "' within the last " +
+                             QString::number(config.notFoundDays) +
+                             " days, skipping search\n");
             } else {
                 // divert into actual scraping
+                int failures = scraper->getNetworkFailures();
+                if (scraper->getBatchSize() > 0) {
+                    QList<QFileInfo> batch = {info};
+                    batch.append(
+                        queue->peekEntries(scraper->getBatchSize() - 1));
+                    scraper->prefetch(batch);
+                }
                 scraper->runPasses(gameEntries, info, output, debug);
+                reliableMiss = scraper->getNetworkFailures() == failures;
             }
         }
 
@@ -264,11 +292,18 @@ void ScraperWorker::run() {
             output.append(
                 QString("\033[1;33m---- Game '%1' not found%2 ----\033[0m\n\n")
                     .arg(info.completeBaseName())
-                    .arg(hint));
+                    .arg(knownMiss ? " (again, retry with '--flags "
+                                     "retrynotfound')"
+                                   : hint));
             game.resetMedia();
             if (!forceEnd) {
                 forceEnd = limitReached(output);
             }
+            // Nothing came back at all and no request failed or hit a limit
+            if (rememberMiss && reliableMiss && !forceEnd &&
+                gameEntries.isEmpty()) {
+                cache->addNotFound(cacheId, config.scraper, missName);
+            }
             emit entryReady(game, output, debug);
             if (forceEnd) {
                 break;
@@ -307,6 +342,14 @@ void ScraperWorker::run() {
                 .arg(info.completeBaseName()));
 
         if (!fromCache) {
+            if (!scraper->getPassVariant().isEmpty()) {
+                PassStats::get().addHit(config.platform, config.scraper,
+                                        scraper->getPassVariant());
+            }
+            if (config.refresh && !cacheScraper) {
+                game.cachedMedia =
+                    cache->getMediaFiles(game.cacheId, config.scraper);
+            }
             scraper->getGameData(game);
         }
 
@@ -472,40 +515,41 @@ void ScraperWorker::run() {
                       game.tagsSrc + ")\n");
         output.append("Rating (0-1):   '\033[1;32m" + game.rating +
                       "\033[0m' (" + game.ratingSrc + ")\n");
+        auto mediaState = [&game](bool found, const QString &type) {
+            if (game.unchangedMedia.contains(type)) {
+                return QString("\033[1;32mUNCHANGED");
+            }
+            return QString(found ? "\033[1;32mYES" : "\033[1;31mNO");
+        };
         output.append(
             "Cover:          " +
-            QString(
-                (game.coverData.isNull() ? "\033[1;31mNO" : "\033[1;32mYES")) +
+            mediaState(!game.coverData.isNull(), "cover") +
             "\033[0m" +
             QString((config.cacheCovers || cacheScraper ? "" : " (uncached)")) +
             " (" + game.coverSrc + ")\n");
         output.append(
             "Screenshot:     " +
-            QString((game.screenshotData.isNull() ? "\033[1;31mNO"
-                                                  : "\033[1;32mYES")) +
+            mediaState(!game.screenshotData.isNull(), "screenshot") +
             "\033[0m" +
             QString((config.cacheScreenshots || cacheScraper ? ""
                                                              : " (uncached)")) +
             " (" + game.screenshotSrc + ")\n");
         output.append(
             "Wheel:          " +
-            QString(
-                (game.wheelData.isNull() ? "\033[1;31mNO" : "\033[1;32mYES")) +
+            mediaState(!game.wheelData.isNull(), "wheel") +
             "\033[0m" +
             QString((config.cacheWheels || cacheScraper ? "" : " (uncached)")) +
             " (" + game.wheelSrc + ")\n");
         output.append(
             "Marquee:        " +
-            QString((game.marqueeData.isNull() ? "\033[1;31mNO"
-                                               : "\033[1;32mYES")) +
+            mediaState(!game.marqueeData.isNull(), "marquee") +
             "\033[0m" +
             QString(
                 (config.cacheMarquees || cacheScraper ? "" : " (uncached)")) +
             " (" + game.marqueeSrc + ")\n");
         output.append(
             "Texture:        " +
-            QString((game.textureData.isNull() ? "\033[1;31mNO"
-                                               : "\033[1;32mYES")) +
+            mediaState(!game.textureData.isNull(), "texture") +
             "\033[0m" +
             QString(
                 (config.cacheTextures || cacheScraper ? "" : " (uncached)")) +
@@ -513,26 +557,23 @@ void ScraperWorker::run() {
         if (config.videos) {
             output.append(
                 "Video:          " +
-                QString((game.videoFormat.isEmpty() ? "\033[1;31mNO"
-                                                    : "\033[1;32mYES")) +
+                mediaState(!game.videoFormat.isEmpty(), "video") +
                 "\033[0m" +
-                QString((game.videoData.size() <= config.videoSizeLimit
-                             ? ""
-                             : " (size exceeded, uncached)")) +
+                QString((game.videoSizeExceeded && game.videoFormat.isEmpty()
+                             ? " (size exceeded, uncached)"
+                             : "")) +
                 " (" + game.videoSrc + ")\n");
         }
         if (config.manuals) {
             output.append(
                 "Manual:         " +
-                QString((game.manualData.isEmpty() ? "\033[1;31mNO"
-                                                   : "\033[1;32mYES")) +
+                mediaState(!game.manualData.isEmpty(), "manual") +
                 "\033[0m (" + game.manualSrc + ")\n");
         }
         if (config.fanart) {
             output.append(
                 "Fanart:         " +
-                QString((game.fanartData.isEmpty() ? "\033[1;31mNO"
-                                                   : "\033[1;32mYES")) +
+                mediaState(!game.fanartData.isEmpty(), "fanart") +
                 "\033[0m (" + game.fanartSrc + ")\n");
         }
         output.append("\nDescription: (" + game.descriptionSrc +
@@ -560,10 +601,14 @@ void ScraperWorker::run() {
 
 bool ScraperWorker::limitReached(QString &output) {
     if (scraper->reqRemaining != -1) { // -1 means there is no limit
-        if (scraper->reqRemaining > 0) {
+        QuotaPlanner &planner = QuotaPlanner::get(config.scraper);
+        planner.reportRemaining(scraper->reqRemaining);
+        if (planner.hasBudget(config.threads) && scraper->reqRemaining > 0) {
             output.append("\n\033[1;33m'" + config.scraper +
                           "' requests remaining: " +
-                          QString::number(scraper->reqRemaining) + "\033[0m\n");
+                          QString::number(scraper->reqRemaining) + " (about " +
+                          QString::number(planner.getGamesLeft()) +
+                          " games)\033[0m\n");
         } else {
             output.append("\033[1;31mForcing thread " + threadId +
                           " to stop...\033[0m\n");
@@ -891,14 +936,12 @@ void ScraperWorker::copyMedia(MediaHint mediaHint, const QString &baseName,
     QString cacheFn, fnExt, mediaTypeFolder;
     bool mediaTypeEnabled = false;
     bool skipExisting = false;
-    QByteArray data;
     QMimeDatabase db;
 
     if (mediaHint & MediaHint::VIDEO & !game.videoFile.isEmpty()) {
         fnExt = game.videoFormat;
         cacheFn = game.videoFile;
         mediaTypeEnabled = config.videos;
-        data = game.videoData;
         mediaTypeFolder = config.videosFolder;
         skipExisting = config.skipExistingVideos;
     } else if (mediaHint & MediaHint::MANUAL && !game.manualFile.isEmpty()) {
@@ -906,7 +949,6 @@ void ScraperWorker::copyMedia(MediaHint mediaHint, const QString &baseName,
         fnExt = mime.preferredSuffix();
         cacheFn = game.manualFile;
         mediaTypeEnabled = config.manuals;
-        data = game.manualData;
         mediaTypeFolder = config.manualsFolder;
         skipExisting = config.skipExistingManuals;
     } else if (mediaHint & MediaHint::FANART && !game.fanartFile.isEmpty()) {
@@ -914,7 +956,6 @@ void ScraperWorker::copyMedia(MediaHint mediaHint, const QString &baseName,
         fnExt = mime.preferredSuffix();
         cacheFn = game.fanartFile;
         mediaTypeEnabled = config.fanart;
-        data = game.fanartData;
         mediaTypeFolder = config.fanartsFolder;
         skipExisting = config.skipExistingFanart;
     }
@@ -957,6 +998,7 @@ void ScraperWorker::copyMedia(MediaHint mediaHint, const QString &baseName,
         absMediaFn = mediaTypeFolder % "/" % absMediaFn;
 
         if (!(skipExisting && QFile::exists(absMediaFn))) {
+            IoGuard ioGuard(absMediaFn);
             QFile::remove(absMediaFn);
             if (config.symlink && mediaHint & MediaHint::VIDEO) {
                 // symlink
@@ -968,10 +1010,8 @@ void ScraperWorker::copyMedia(MediaHint mediaHint, const QString &baseName,
                                << absMediaFn << "->" << cacheFn;
                 }
             } else {
-                QFile fh(absMediaFn);
-                if (fh.open(QIODevice::WriteOnly)) {
-                    fh.write(data);
-                    fh.close();
+                // File to file, large videos don't pass through memory
+                if (QFile::copy(cacheFn, absMediaFn)) {
                     zapInGamelist = false;
                 } else {
                     qWarning()
@@ -40,8 +40,7 @@ class ScraperWorker : public QObject {
 
 public:
     ScraperWorker(QSharedPointer<Queue> queue, QSharedPointer<Cache> cache,
-                  QSharedPointer<NetManager> manager, Settings config,
-                  QString threadId);
+                  Settings config, QString threadId);
     ~ScraperWorker();
     void run();
     bool forceEnd = false;
@@ -27,9 +27,11 @@
 
 #include "config.h"
 #include "crc32.h"
+#include "iolimiter.h"
 #include "platform.h"
 #include "strtools.h"
 
+#include <QCryptographicHash>
 #include <QDebug>
 #include <QFileInfo>
 #include <QJsonDocument>
@@ -42,13 +44,6 @@ constexpr int MINARTSIZE = 256;
 ScreenScraper::ScreenScraper(Settings *config,
                              QSharedPointer<NetManager> manager)
     : AbstractScraper(config, manager, MatchType::MATCH_ONE) {
-    connect(&limitTimer, &QTimer::timeout, &limiter, &QEventLoop::quit);
-    limitTimer.setInterval(
-        1200); // 1.2 second request limit set a bit above 1.0 as requested by
-               // the good folks at ScreenScraper. Don't change!
-    limitTimer.setSingleShot(false);
-    limitTimer.start();
-
     baseUrl = "http://www.screenscraper.fr";
 
     fetchOrder.append(GameEntry::Elem::PUBLISHER);
@@ -91,7 +86,6 @@ void ScreenScraper::getSearchResults(QList<GameEntry> &gameEntries,
         "&output=json&" + searchName;
 
     for (int retries = 0; retries < RETRIESMAX; ++retries) {
-        limiter.exec();
         netComm->request(gameUrl);
         q.exec();
         data = netComm->getData();
@@ -101,22 +95,27 @@ void ScreenScraper::getSearchResults(QList<GameEntry> &gameEntries,
         // Do error checks on headerData. It's more stable than checking the
         // potentially faulty JSON
         if (headerData.isEmpty()) {
-            printf("\033[1;33mRetrying request...\033[0m\n\n");
-            continue;
+            // NetComm has retried with backoff already
+            return;
         } else if (headerData.contains("non trouvée")) {
             return;
         } else if (headerData.contains("API totalement fermé")) {
+            // Only a game or a "not found" is worth keeping in the response
+            // cache, the errors here may be gone on the next request
+            netComm->dropCachedReply();
             printf("\033[1;31mThe ScreenScraper API is currently closed, "
                    "exiting nicely...\033[0m\n\n");
             reqRemaining = 0;
             return;
         } else if (headerData.contains(
                        "Le logiciel de scrape utilisé a été blacklisté")) {
+            netComm->dropCachedReply();
             printf("\033[1;31mSkyscraper has apparently been blacklisted at "
                    "ScreenScraper, exiting nicely...\033[0m\n\n");
             reqRemaining = 0;
             return;
         } else if (headerData.contains("Votre quota de scrape est")) {
+            netComm->dropCachedReply();
             printf("\033[1;31mYour daily ScreenScraper request limit has been "
                    "reached, exiting nicely...\033[0m\n\n");
             reqRemaining = 0;
@@ -132,6 +131,7 @@ void ScreenScraper::getSearchResults(QList<GameEntry> &gameEntries,
                 "****u****s****e****r****s**** ****i****s**** "
                 "****a****l****r****e****a****d****y**** "
                 "****u****s****e****d****")) {
+            netComm->dropCachedReply();
             printf(
                 "\033[1;31mThe screenscraper service is currently closed or "
                 "too busy to handle requests from unregistered and inactive "
@@ -157,6 +157,7 @@ void ScreenScraper::getSearchResults(QList<GameEntry> &gameEntries,
 
         // Check if we got a valid JSON document back
         if (jsonObj.isEmpty()) {
+            netComm->dropCachedReply();
             printf("\033[1;31mScreenScraper APIv2 returned invalid / empty "
                    "Json. Their servers are probably down. Please try again "
                    "later or use a different scraping module with '-s MODULE'. "
@@ -208,13 +209,20 @@ void ScreenScraper::getSearchResults(QList<GameEntry> &gameEntries,
                        .toString()
                        .toStdString()
                        .c_str());
+            netComm->dropCachedReply();
+            if (netComm->isFromCache()) {
+                // A failure of an earlier run, don't retry on the cache
+                break;
+            }
             // Try again. We handle important errors above, so something weird
             // is going on here
             continue;
         }
 
-        // Check if user has exceeded daily request limit
-        if (!jsonObj["response"]
+        // Check if user has exceeded daily request limit. A cached reply
+        // carries the request counts of the day it was received
+        if (!netComm->isFromCache() &&
+            !jsonObj["response"]
                  .toObject()["ssuser"]
                  .toObject()["requeststoday"]
                  .toString()
@@ -353,50 +361,80 @@ void ScreenScraper::getTags(GameEntry &game) {
     game.tags.chop(2);
 }
 
-QByteArray ScreenScraper::downloadImageWithRetry(const QString &url) {
-    QByteArray d;
-    if (!url.isEmpty()) {
-        for (int retries = 0; retries < RETRIESMAX; ++retries) {
-            limiter.exec();
-            d = downloadMedia(url);
-            if (d.size() >= MINARTSIZE) {
-                break;
-            }
-        }
+void ScreenScraper::queueImageWithRetry(const QString &url,
+                                        QByteArray &target, bool fullSize) {
+    QString sizedUrl = url;
+    int maxSize = getMaxImageSize();
+    if (!fullSize && maxSize > 0 && !url.isEmpty()) {
+        // Let the server scale it down to what the cache keeps anyway
+        sizedUrl += QString("&maxwidth=%1&maxheight=%1").arg(maxSize);
     }
-    return d;
+    queueMedia(
+        {sizedUrl},
+        [&target](const QByteArray &d, const QByteArray &) {
+            target = d;
+            return d.size() >= MINARTSIZE;
+        },
+        true, RETRIESMAX);
 }
 
-void ScreenScraper::downloadBinary(const QString &url, const QString &type,
-                                   GameEntry &game) {
-    for (int retries = 0; retries < RETRIESMAX; ++retries) {
-        limiter.exec();
-        netComm->request(url);
-        q.exec();
-        if (netComm->getError(config->verbosity) == QNetworkReply::NoError) {
-            QByteArray contentType = netComm->getContentType().toLower();
-            // Make sure received data is actually a video or  PDF file
-            QByteArray d = netComm->getData();
-            if (type == "video") {
-                if (contentType.contains("video/") && d.size() > 4096) {
-                    game.videoData = d;
-                    game.videoFormat = contentType.mid(
-                        contentType.indexOf("/") + 1,
-                        contentType.length() - contentType.indexOf("/") + 1);
-                    break;
-                }
-            } else if (type == "manuel") {
-                // Screenscraper.fr:
-                // Content-Type: application/force-download; name="1943 - The
-                // Battle Of Midway-manuel(us).pdf"
-                if (contentType.startsWith("application/") &&
-                    contentType.contains(".pdf")) {
-                    game.manualData = d;
-                    break;
-                }
-            }
+bool ScreenScraper::isUnchanged(const QString &url, GameEntry &game,
+                                const QString &type) {
+    if (url.isEmpty() || !game.cachedMedia.contains(type)) {
+        return false;
+    }
+    // The cache keeps these scaled down, their checksum never matches the
+    // one of the original file
+    static const QStringList resizedTypes = {"cover", "screenshot", "wheel",
+                                             "marquee", "texture"};
+    if (getMaxImageSize() > 0 && resizedTypes.contains(type)) {
+        return false;
+    }
+    // The media list has the checksum of each file, compare it with the
+    // cached one before downloading it again
+    QString md5;
+    for (const auto &media : jsonObj["medias"].toArray()) {
+        if (media.toObject()["url"].toString() == url) {
+            md5 = media.toObject()["md5"].toString().toLower();
+            break;
         }
     }
+    if (md5.isEmpty()) {
+        return false;
+    }
+    QFile f(game.cachedMedia.value(type));
+    IoGuard ioGuard(f.fileName());
+    if (!f.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QCryptographicHash hash(QCryptographicHash::Md5);
+    hash.addData(&f);
+    f.close();
+    if (hash.result().toHex() != md5) {
+        return false;
+    }
+    qDebug() << "Unchanged" << type << url;
+    game.unchangedMedia.insert(type);
+    return true;
+}
+
+void ScreenScraper::queueManual(const QString &url, GameEntry &game) {
+    queueMedia(
+        {url},
+        [&game](const QByteArray &d, const QByteArray &ct) {
+            QByteArray contentType = ct.toLower();
+            // Make sure received data is actually a PDF file
+            // Screenscraper.fr:
+            // Content-Type: application/force-download; name="1943 - The
+            // Battle Of Midway-manuel(us).pdf"
+            if (contentType.startsWith("application/") &&
+                contentType.contains(".pdf")) {
+                game.manualData = d;
+                return true;
+            }
+            return false;
+        },
+        false, RETRIESMAX);
 }
 
 void ScreenScraper::getCover(GameEntry &game) {
@@ -411,32 +449,42 @@ void ScreenScraper::getCover(GameEntry &game) {
         url = getJsonText(jsonObj["medias"].toArray(), REGION,
                           QList<QString>({"box-2D"}));
     }
-    game.coverData = downloadImageWithRetry(url);
+    if (!isUnchanged(url, game, "cover")) {
+        queueImageWithRetry(url, game.coverData);
+    }
 }
 
 void ScreenScraper::getScreenshot(GameEntry &game) {
     QString url = getJsonText(jsonObj["medias"].toArray(), REGION,
                               QList<QString>({"ss", "sstitle"}));
-    game.screenshotData = downloadImageWithRetry(url);
+    if (!isUnchanged(url, game, "screenshot")) {
+        queueImageWithRetry(url, game.screenshotData);
+    }
 }
 
 void ScreenScraper::getWheel(GameEntry &game) {
     QString url = getJsonText(jsonObj["medias"].toArray(), REGION,
                               QList<QString>({"wheel(-hd)?"}));
-    game.wheelData = downloadImageWithRetry(url);
+    if (!isUnchanged(url, game, "wheel")) {
+        queueImageWithRetry(url, game.wheelData);
+    }
 }
 
 void ScreenScraper::getMarquee(GameEntry &game) {
     QString url = getJsonText(jsonObj["medias"].toArray(), REGION,
                               QList<QString>({"screenmarquee"}));
-    game.marqueeData = downloadImageWithRetry(url);
+    if (!isUnchanged(url, game, "marquee")) {
+        queueImageWithRetry(url, game.marqueeData);
+    }
 }
 
 void ScreenScraper::getTexture(GameEntry &game) {
     QString url =
         getJsonText(jsonObj["medias"].toArray(), REGION,
                     QList<QString>({"support-2[Dd]", "support-texture"}));
-    game.textureData = downloadImageWithRetry(url);
+    if (!isUnchanged(url, game, "texture")) {
+        queueImageWithRetry(url, game.textureData);
+    }
 }
 
 void ScreenScraper::getVideo(GameEntry &game) {
@@ -446,23 +494,24 @@ void ScreenScraper::getVideo(GameEntry &game) {
     }
     types.append("video");
     QString url = getJsonText(jsonObj["medias"].toArray(), NONE, types);
-    if (!url.isEmpty()) {
-        downloadBinary(url, types.last(), game);
+    if (!url.isEmpty() && !isUnchanged(url, game, "video")) {
+        // Format from the content type, which also proves it is a video
+        queueVideo({url}, game, "", RETRIESMAX);
     }
 }
 
 void ScreenScraper::getManual(GameEntry &game) {
     QStringList types = {"manuel"};
     QString url = getJsonText(jsonObj["medias"].toArray(), REGION, types);
-    if (!url.isEmpty()) {
-        downloadBinary(url, types.last(), game);
+    if (!url.isEmpty() && !isUnchanged(url, game, "manual")) {
+        queueManual(url, game);
     }
 }
 
 void ScreenScraper::getFanart(GameEntry &game) {
     QString url = getJsonText(jsonObj["medias"].toArray(), NONE, {"fanart"});
-    if (!url.isEmpty()) {
-        game.fanartData = downloadImageWithRetry(url);
+    if (!url.isEmpty() && !isUnchanged(url, game, "fanart")) {
+        queueImageWithRetry(url, game.fanartData, true);
     }
 }
 
@@ -28,9 +28,7 @@
 
 #include "abstractscraper.h"
 
-#include <QEventLoop>
 #include <QJsonObject>
-#include <QTimer>
 
 constexpr int REGION = 0;
 constexpr int LANGUE = 1;
@@ -46,8 +44,6 @@ protected:
     QString applyQuerySearchName(QString query) override;
 
 private:
-    QTimer limitTimer;
-    QEventLoop limiter;
     QList<QString> getSearchNames(const QFileInfo &info,
                                   QString &debug) override;
     void getSearchResults(QList<GameEntry> &gameEntries, QString searchName,
@@ -73,9 +69,10 @@ private:
 
     QString getJsonText(QJsonArray array, int attr,
                         QList<QString> types = QList<QString>());
-    QByteArray downloadImageWithRetry(const QString &url);
-    void downloadBinary(const QString &url, const QString &type,
-                        GameEntry &game);
+    void queueImageWithRetry(const QString &url, QByteArray &target,
+                             bool fullSize = false);
+    void queueManual(const QString &url, GameEntry &game);
+    bool isUnchanged(const QString &url, GameEntry &game, const QString &type);
     QString getUrlOrTextPropertyValue(const QJsonObject &jsonVal,
                                       const QString &key,
                                       const QString &matchValue);
@@ -239,6 +239,20 @@ void RuntimeCfg::applyConfigIni(CfgType type, QSettings *settings,
                 config->includePattern = v;
                 continue;
             }
+            if (k == "netFixtureFolder") {
+                config->netFixtureFolder = toAbsolutePath(false, v);
+                continue;
+            }
+            if (k == "netFixtureMode") {
+                if (v == "record" || v == "replay" || v == "replaytimed") {
+                    config->netFixtureMode = v;
+                } else {
+                    printf("\033[1;33mParameter netFixtureMode must be one "
+                           "of 'record', 'replay' or 'replaytimed', ignoring "
+                           "it.\n\033[0m");
+                }
+                continue;
+            }
             if (k == "includeFrom") {
                 config->includeFrom = v;
                 continue;
@@ -399,6 +413,10 @@ void RuntimeCfg::applyConfigIni(CfgType type, QSettings *settings,
                 config->keepDiscInfo = v;
                 continue;
             }
+            if (k == "localityOrder") {
+                config->localityOrder = v;
+                continue;
+            }
             if (k == "mediaFolderHidden") {
                 QStringList allowedFe({"emulationstation", "retrobat"});
                 if (allowedFe.contains(config->frontend)) {
@@ -491,6 +509,16 @@ void RuntimeCfg::applyConfigIni(CfgType type, QSettings *settings,
                        k.toUtf8().constData());
                 exit(1);
             }
+            if (k == "ioThreads") {
+                if (0 <= v && v <= 32) {
+                    config->ioThreads = v;
+                } else {
+                    printf("\033[1;33mValue of %d is out of range and is "
+                           "ignored! Consult the documentation.\n\033[0m",
+                           v);
+                }
+                continue;
+            }
             if (k == "jpgQuality") {
                 if (0 < v && v <= 100) {
                     config->jpgQuality = v;
@@ -528,6 +556,26 @@ void RuntimeCfg::applyConfigIni(CfgType type, QSettings *settings,
                 }
                 continue;
             }
+            if (k == "notFoundDays") {
+                if (0 <= v && v <= 365) {
+                    config->notFoundDays = v;
+                } else {
+                    printf("\033[1;33mValue of %d is out of range and is "
+                           "ignored! Consult the documentation.\n\033[0m",
+                           v);
+                }
+                continue;
+            }
+            if (k == "responseCacheDays") {
+                if (0 <= v && v <= 365) {
+                    config->responseCacheDays = v;
+                } else {
+                    printf("\033[1;33mValue of %d is out of range and is "
+                           "ignored! Consult the documentation.\n\033[0m",
+                           v);
+                }
+                continue;
+            }
             if (k == "threads") {
                 config->threads = v;
                 config->threadsSet = true;
@@ -621,6 +669,9 @@ void RuntimeCfg::applyCli(bool &inputFolderSet, bool &gameListFolderSet,
     if (parser->isSet("refresh")) {
         config->refresh = true;
     }
+    if (parser->isSet("watch")) {
+        config->watch = true;
+    }
     if (parser->isSet("hint")) {
         Cli::showHint();
         exit(0);
@@ -705,6 +756,8 @@ void RuntimeCfg::setFlag(const QString flag) {
         config->pretend = true;
     } else if (flag == "relative") {
         config->relativePaths = true;
+    } else if (flag == "retrynotfound") {
+        config->retryNotFound = true;
     } else if (flag == "skipexistingcovers") {
         config->skipExistingCovers = true;
     } else if (flag == "skipexistingmanuals") {
@@ -33,6 +33,9 @@
 #include <QPair>
 #include <QSettings>
 
+// Largest width and height of cached images with cacheResize enabled
+constexpr int CACHERESIZEMAX = 800;
+
 struct Settings {
     bool isMatchOneScraper() {
         const QStringList matchOneScraper = QStringList(
@@ -72,6 +75,13 @@ struct Settings {
     QString nameTemplate = "";
     int doneThreads = 0;
     int threads = 4;
+    int ioThreads = 0;
+    bool localityOrder = false;
+    int responseCacheDays = 7;
+    int notFoundDays = 14;
+    QString netFixtureFolder = "";
+    QString netFixtureMode = "";
+    bool retryNotFound = false;
     bool threadsSet = false;
     int minMatch = 65;
     bool minMatchSet = false;
@@ -79,6 +89,7 @@ struct Settings {
     bool brackets = true;
     bool keepDiscInfo = false;
     bool refresh = false;
+    bool watch = false;
     QString cacheOptions = "";
     bool cacheResize = true;
     int jpgQuality = 95;
@@ -231,11 +242,13 @@ private:
         {"innerParenthesesReplace", QPair<QString, int>("str",  CfgType::MAIN                                                            )},
         {"inputFolder",             QPair<QString, int>("str",  CfgType::MAIN | CfgType::PLATFORM                                        )},
         {"interactive",             QPair<QString, int>("bool", CfgType::MAIN | CfgType::PLATFORM |                     CfgType::SCRAPER )},
+        {"ioThreads",               QPair<QString, int>("int",  CfgType::MAIN | CfgType::PLATFORM                                        )},
         {"jpgQuality",              QPair<QString, int>("int",  CfgType::MAIN | CfgType::PLATFORM |                     CfgType::SCRAPER )},        
         {"keepDiscInfo",            QPair<QString, int>("bool", CfgType::MAIN | CfgType::PLATFORM                                        )},
         {"lang",                    QPair<QString, int>("str",  CfgType::MAIN | CfgType::PLATFORM                                        )},
         {"langPrios",               QPair<QString, int>("str",  CfgType::MAIN | CfgType::PLATFORM                                        )},
         {"launch",                  QPair<QString, int>("str",  CfgType::MAIN | CfgType::PLATFORM | CfgType::FRONTEND                    )},
+        {"localityOrder",           QPair<QString, int>("bool", CfgType::MAIN | CfgType::PLATFORM                                        )},
         {"manuals",                 QPair<QString, int>("bool", CfgType::MAIN | CfgType::PLATFORM                                        )},
         {"maxFails",                QPair<QString, int>("int",  CfgType::MAIN                                                            )},
         {"maxLength",               QPair<QString, int>("int",  CfgType::MAIN | CfgType::PLATFORM | CfgType::FRONTEND | CfgType::SCRAPER )},
@@ -243,12 +256,16 @@ private:
         {"mediaFolderHidden",       QPair<QString, int>("bool",                                     CfgType::FRONTEND                    )},
         {"minMatch",                QPair<QString, int>("int",  CfgType::MAIN | CfgType::PLATFORM |                     CfgType::SCRAPER )},
         {"nameTemplate",            QPair<QString, int>("str",  CfgType::MAIN | CfgType::PLATFORM                                        )},
+        {"netFixtureFolder",        QPair<QString, int>("str",  CfgType::MAIN                                                            )},
+        {"netFixtureMode",          QPair<QString, int>("str",  CfgType::MAIN                                                            )},
+        {"notFoundDays",            QPair<QString, int>("int",  CfgType::MAIN | CfgType::PLATFORM |                     CfgType::SCRAPER )},
         {"onlyMissing",             QPair<QString, int>("bool", CfgType::MAIN | CfgType::PLATFORM |                     CfgType::SCRAPER )},
         {"platform",                QPair<QString, int>("str",  CfgType::MAIN                                                            )},
         {"pretend",                 QPair<QString, int>("bool", CfgType::MAIN | CfgType::PLATFORM                                        )},
         {"region",                  QPair<QString, int>("str",  CfgType::MAIN | CfgType::PLATFORM                                        )},
         {"regionPrios",             QPair<QString, int>("str",  CfgType::MAIN | CfgType::PLATFORM                                        )},
         {"relativePaths",           QPair<QString, int>("bool", CfgType::MAIN | CfgType::PLATFORM                                        )},
+        {"responseCacheDays",       QPair<QString, int>("int",  CfgType::MAIN | CfgType::PLATFORM |                     CfgType::SCRAPER )},
         {"scummIni",                QPair<QString, int>("str",  CfgType::MAIN                                                            )},
         {"skipped",                 QPair<QString, int>("bool", CfgType::MAIN | CfgType::PLATFORM | CfgType::FRONTEND                    )},
         {"spaceCheck",              QPair<QString, int>("bool", CfgType::MAIN                                                            )},
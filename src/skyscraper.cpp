@@ -32,9 +32,18 @@
 #include "config.h"
 #include "emulationstation.h"
 #include "esde.h"
+#include "filediscovery.h"
+#include "iolimiter.h"
+#include "nametools.h"
+#include "netfixtures.h"
+#include "passstats.h"
 #include "pegasus.h"
+#include "quotaplanner.h"
+#include "ratelimiter.h"
+#include "responsecache.h"
 #include "settings.h"
 #include "strtools.h"
+#include "watcher.h"
 
 #include <QDebug>
 #include <QDirIterator>
@@ -134,11 +143,28 @@ void Skyscraper::run() {
         showHint();
     }
 
+    if (!config.netFixtureMode.isEmpty()) {
+        QString folder = config.netFixtureFolder.isEmpty()
+                             ? Config::getSkyFolder() % "/fixtures"
+                             : config.netFixtureFolder;
+        NetFixtures::Mode mode = NetFixtures::REPLAY_TIMED;
+        if (config.netFixtureMode == "record") {
+            mode = NetFixtures::RECORD;
+        } else if (config.netFixtureMode == "replay") {
+            mode = NetFixtures::REPLAY;
+        }
+        NetFixtures::get().setMode(mode, folder);
+        printf("Network fixtures:   '\033[1;33m%s\033[0m' (%s)\n\n",
+               folder.toStdString().c_str(),
+               config.netFixtureMode.toStdString().c_str());
+    }
+
     prepareScraping();
 
     doneThreads = 0;
     notFound = 0;
     found = 0;
+    moduleCounts.clear();
     avgCompleteness = 0;
     avgSearchMatch = 0;
 
@@ -157,7 +183,13 @@ void Skyscraper::run() {
     }
 
     cache = QSharedPointer<Cache>(new Cache(config.cacheFolder));
-    if (cacheScrapeMode || cache->createFolders(config.scraper)) {
+    bool foldersCreated =
+        cacheScrapeMode || cache->createFolders(config.scraper);
+    for (const auto &extraConfig : extraConfigs) {
+        foldersCreated =
+            foldersCreated && cache->createFolders(extraConfig.scraper);
+    }
+    if (foldersCreated) {
         if (!cache->read() && cacheScrapeMode) {
             printf("No resources for this platform found in the resource "
                    "cache ('%s'). Please verify the path of the cache or "
@@ -316,7 +348,12 @@ void Skyscraper::run() {
         printf("Pretend set! Not changing any files, just showing output.\n\n");
     }
 
-    QFile::remove(skippedFileString);
+    QFile::remove(getModuleFileString("skipped", config.scraper));
+    QFile::remove(getModuleFileString("continue", config.scraper));
+    for (const auto &extraConfig : extraConfigs) {
+        QFile::remove(getModuleFileString("skipped", extraConfig.scraper));
+        QFile::remove(getModuleFileString("continue", extraConfig.scraper));
+    }
 
     if (gameListFile.exists()) {
         printf("Trying to parse and load existing game list metadata... ");
@@ -405,41 +442,262 @@ void Skyscraper::run() {
         exit(1);
     }
 
+    scheduleQueue();
+
     if (!doCacheScraping) {
+        int threads = config.threads;
+        QStringList modules = {config.scraper};
+        for (const auto &extraConfig : extraConfigs) {
+            threads += extraConfig.threads;
+            modules.append(extraConfig.scraper);
+        }
+        if (!extraConfigs.isEmpty()) {
+            printf("Scraping concurrently with modules: \033[1;32m%s\033[0m\n",
+                   modules.join(", ").toStdString().c_str());
+        }
         printf("Starting scraping run on \033[1;32m%d\033[0m files using "
                "\033[1;32m%d\033[0m threads.\nSit back, relax and let me do "
                "the work! :)\n",
-               totalFiles, config.threads);
+               totalFiles, threads);
     }
     printf("\n");
 
+    // Disk operations get their own concurrency limit per storage device.
+    // Registration order does not matter, same devices are merged
+    IoLimiter::get().addStorage(config.inputFolder, config.ioThreads);
+    IoLimiter::get().addStorage(config.cacheFolder, config.ioThreads);
+    if (cacheScrapeMode) {
+        IoLimiter::get().addStorage(config.screenshotsFolder, config.ioThreads);
+        IoLimiter::get().addStorage(config.videosFolder, config.ioThreads);
+    } else if (config.responseCacheDays > 0 &&
+               NetFixtures::get().getMode() == NetFixtures::OFF) {
+        // Fixtures shall see every request
+        ResponseCache::get().setFolder(
+            Config::getSkyFolder(Config::SkyFolderType::CACHE) % "/http");
+        ResponseCache::get().purgeExpired(config.responseCacheDays * 24 * 60 *
+                                          60);
+    }
+    if (!cacheScrapeMode) {
+        PassStats::get().load(
+            Config::getSkyFolder(Config::SkyFolderType::CACHE) %
+            "/passstats.json");
+    }
+
+    if (config.watch) {
+        startWatcher();
+        // Changes picked up during the initial run are handled afterwards
+        batchRunning = true;
+    }
+    startThreads();
+}
+
+void Skyscraper::startThreads() {
     timer.start();
+    lastEntryTime = 0;
     currentFile = 1;
+    doneThreads = 0;
 
     QList<QThread *> threadList;
-    for (int curThread = 1; curThread <= config.threads; ++curThread) {
+    addWorkers(threadList, queue, config);
+    // Further modules work through their own copy of the scheduled queue.
+    // The game list pass of watch mode only reads the cache
+    extraQueues.clear();
+    if (!watchGameListPass) {
+        for (const auto &extraConfig : extraConfigs) {
+            QSharedPointer<Queue> extraQueue =
+                QSharedPointer<Queue>(new Queue());
+            extraQueue->append(*queue);
+            extraQueues.append(extraQueue);
+            addWorkers(threadList, extraQueue, extraConfig);
+        }
+        for (int c = 0; c < Queue::COSTS; ++c) {
+            costsLeft[c] *= extraQueues.size() + 1;
+        }
+    }
+    runningThreads = threadList.size();
+    // Ready, set, GO! Start all threads
+    for (const auto thread : threadList) {
+        thread->start();
+        state = THREADED;
+    }
+}
+
+void Skyscraper::addWorkers(QList<QThread *> &threadList,
+                            QSharedPointer<Queue> workQueue,
+                            const Settings &cfg) {
+    for (int curThread = 1; curThread <= cfg.threads; ++curThread) {
         QThread *thread = new QThread;
-        ScraperWorker *worker = new ScraperWorker(queue, cache, manager, config,
-                                                  QString::number(curThread));
+        ScraperWorker *worker =
+            new ScraperWorker(workQueue, cache, cfg,
+                              QString::number(threadList.size() + 1));
         worker->moveToThread(thread);
         connect(thread, &QThread::started, worker, &ScraperWorker::run);
+        const QString scraper = cfg.scraper;
         connect(worker, &ScraperWorker::entryReady, this,
-                &Skyscraper::entryReady);
+                [this, scraper](const GameEntry &entry, const QString &output,
+                                const QString &debug) {
+                    entryReady(entry, output, debug, scraper);
+                });
         connect(worker, &ScraperWorker::allDone, this,
                 &Skyscraper::checkThreads);
+        connect(worker, &ScraperWorker::allDone, thread, &QThread::quit);
         connect(thread, &QThread::finished, worker,
                 &ScraperWorker::deleteLater);
+        connect(thread, &QThread::finished, thread, &QThread::deleteLater);
         threadList.append(thread);
         // Do not start more threads if we have less files than allowed threads
         if (curThread == totalFiles) {
-            config.threads = curThread;
             break;
         }
     }
-    // Ready, set, GO! Start all threads
-    for (const auto thread : threadList) {
-        thread->start();
-        state = THREADED;
+}
+
+void Skyscraper::startWatcher() {
+    QDir::Filters filter = QDir::Files;
+    if (config.platform == "scummvm") {
+        filter |= QDir::Dirs;
+    }
+    watcher = new Watcher(config.inputFolder, getPlatformFileExtensions(),
+                          filter, config.subdirs, !cacheScrapeMode);
+    connect(watcher, &Watcher::filesChanged, this,
+            &Skyscraper::watchedFilesChanged);
+    watcher->start();
+    // The signal handler can only set the flag, leave from the event loop
+    watchQuitTimer.setInterval(250);
+    connect(&watchQuitTimer, &QTimer::timeout, this, [this]() {
+        if (watchQuit && state == WATCH_IDLE) {
+            stopWatching();
+        }
+    });
+    watchQuitTimer.start();
+
+    if (cacheScrapeMode) {
+        // Game list entries of the initial run are kept in gameEntries
+        return;
+    }
+    // With a scraping module each batch is followed by a game list generation
+    // pass for the same files. This needs the existing game list entries
+    if (!QFileInfo::exists(gameListFileString)) {
+        updateGameList = true;
+    } else if (frontend->canSkip() &&
+               frontend->loadOldGameList(gameListFileString)) {
+        QSharedPointer<Queue> noFiles = QSharedPointer<Queue>(new Queue());
+        frontend->skipExisting(gameListEntries, noFiles);
+        updateGameList = true;
+    } else {
+        printf("\033[1;33mCan't load existing game list '%s' for frontend "
+               "'%s'. Only the resource cache will be updated while "
+               "watching.\033[0m\n",
+               gameListFileString.toStdString().c_str(),
+               config.frontend.toStdString().c_str());
+    }
+}
+
+void Skyscraper::watchedFilesChanged(const QList<QFileInfo> &files) {
+    if (watchQuit) {
+        return;
+    }
+    pendingFiles.append(files);
+    if (!batchRunning) {
+        startWatchBatch();
+    }
+}
+
+void Skyscraper::startWatchBatch() {
+    queue->clearAll();
+    queue->append(pendingFiles);
+    pendingFiles.clear();
+    if (!config.excludePattern.isEmpty()) {
+        queue->filterFiles(config.excludePattern);
+    }
+    if (!config.includePattern.isEmpty()) {
+        queue->filterFiles(config.includePattern, true);
+    }
+    if (!config.excludeFrom.isEmpty()) {
+        queue->removeFiles(readFileListFrom(config.excludeFrom));
+    }
+    if (queue->isEmpty()) {
+        return;
+    }
+    batchFiles = *queue;
+    if (cacheScrapeMode) {
+        removeGameEntries(batchFiles);
+    }
+    printf("\033[1;34m---- Picked up %d new or changed file(s) "
+           "----\033[0m\n\n",
+           (int)batchFiles.size());
+    startBatch();
+}
+
+void Skyscraper::startBatch() {
+    batchRunning = true;
+    totalFiles = queue->length();
+    notFound = 0;
+    found = 0;
+    moduleCounts.clear();
+    avgCompleteness = 0;
+    avgSearchMatch = 0;
+    scheduleQueue();
+    startThreads();
+}
+
+void Skyscraper::finishWatchBatch() {
+    if (!cacheScrapeMode && updateGameList && !watchGameListPass &&
+        !batchFiles.isEmpty()) {
+        // Chain a game list generation for the freshly scraped files
+        watchGameListPass = true;
+        scrapingModule = config.scraper;
+        config.scraper = "cache";
+        setMediaFolders(!config.pretend);
+        gameEntries = gameListEntries;
+        removeGameEntries(batchFiles);
+        queue->clearAll();
+        queue->append(batchFiles);
+        startBatch();
+        return;
+    }
+    if (watchGameListPass) {
+        gameListEntries = gameEntries;
+        config.scraper = scrapingModule;
+        watchGameListPass = false;
+    }
+    batchFiles.clear();
+    batchRunning = false;
+    if (!pendingFiles.isEmpty()) {
+        startWatchBatch();
+    }
+    if (!batchRunning) {
+        state = WATCH_IDLE;
+        printf("Watching '\033[1;32m%s\033[0m' for new or changed files, "
+               "press Ctrl+C to quit...\n\n",
+               config.inputFolder.toStdString().c_str());
+    }
+}
+
+void Skyscraper::stopWatching() {
+    if (batchRunning) {
+        // checkThreads() finishes once the running batch is done
+        return;
+    }
+    state = SINGLE;
+    watchQuitTimer.stop();
+    if (watcher != nullptr) {
+        watcher->deleteLater();
+        watcher = nullptr;
+    }
+    emit finished();
+}
+
+void Skyscraper::removeGameEntries(const QList<QFileInfo> &files) {
+    QSet<QString> filePaths;
+    for (const auto &info : files) {
+        filePaths.insert(info.absoluteFilePath());
+    }
+    QMutableListIterator<GameEntry> it(gameEntries);
+    while (it.hasNext()) {
+        if (filePaths.contains(QFileInfo(it.next().path).absoluteFilePath())) {
+            it.remove();
+        }
     }
 }
 
@@ -460,23 +718,7 @@ void Skyscraper::prepareFileQueue() {
         exit(1);
     }
 
-    setFolder(doCacheScraping, config.gameListFolder);
-    setFolder(doCacheScraping, config.coversFolder);
-    setFolder(doCacheScraping, config.screenshotsFolder);
-    setFolder(doCacheScraping, config.wheelsFolder);
-    setFolder(doCacheScraping, config.marqueesFolder);
-    setFolder(doCacheScraping, config.texturesFolder);
-    if (config.videos) {
-        setFolder(doCacheScraping, config.videosFolder);
-    }
-    if (config.manuals) {
-        setFolder(doCacheScraping, config.manualsFolder);
-    }
-    if (config.fanart) {
-        setFolder(doCacheScraping, config.fanartsFolder);
-    }
-
-    setFolder(doCacheScraping, config.importFolder, false);
+    setMediaFolders(doCacheScraping);
 
     QList<QFileInfo> infoList = inputDir.entryInfoList();
     if (!cacheScrapeMode &&
@@ -518,30 +760,13 @@ void Skyscraper::prepareFileQueue() {
     queue->append(infoList);
 
     if (config.subdirs) {
-        QDirIterator dirIt(config.inputFolder,
-                           QDir::Dirs | QDir::NoDotAndDotDot,
-                           QDirIterator::Subdirectories);
-        QString exclude = "";
-        while (dirIt.hasNext()) {
-            QString subdir = dirIt.next();
-            if (!cacheScrapeMode &&
-                QFileInfo::exists(subdir + "/.skyscraperignoretree")) {
-                exclude = subdir;
-            }
-            if (!exclude.isEmpty() &&
-                (subdir == exclude ||
-                 (subdir.left(exclude.length()) == exclude &&
-                  subdir.mid(exclude.length(), 1) == "/"))) {
-                continue;
-            } else {
-                exclude.clear();
-            }
-            if (!cacheScrapeMode &&
-                QFileInfo::exists(subdir + "/.skyscraperignore")) {
-                continue;
-            }
-            inputDir.setPath(subdir);
-            QList<QFileInfo> subFiles = inputDir.entryInfoList();
+        FileDiscovery discovery(getPlatformFileExtensions(), filter,
+                                !cacheScrapeMode);
+        QMap<QString, QList<QFileInfo>> subdirFiles =
+            discovery.scanSubdirs(config.inputFolder);
+        for (auto it = subdirFiles.begin(); it != subdirFiles.end(); ++it) {
+            const QString &subdir = it.key();
+            QList<QFileInfo> &subFiles = it.value();
             if (config.platform == "scummvm" &&
                 config.frontend == "emulationstation") {
                 // special case: avoid having files like
@@ -584,6 +809,103 @@ void Skyscraper::prepareFileQueue() {
     }
 }
 
+void Skyscraper::scheduleQueue() {
+    for (int c = 0; c < Queue::COSTS; ++c) {
+        costsLeft[c] = 0;
+        avgCostTime[c] = -1.0;
+    }
+    if (config.localityOrder) {
+        // Cost ordering below keeps the relative order within each class
+        queue->orderByLocality();
+    }
+    if (config.scraper == "cache") {
+        // Everything is local, keep the queue in name (or locality) order
+        costsLeft[Queue::NETWORK] = queue->length();
+        return;
+    }
+
+    QSet<QString> scraperIds = cache->getCacheIdSet(config.scraper);
+    QSet<QString> allIds;
+    if (config.onlyMissing) {
+        allIds = cache->getCacheIdSet();
+    }
+    QHash<QString, Queue::EntryCost> costs;
+    for (const auto &info : *queue) {
+        QString cacheId = cache->getQuickId(info);
+        if (cacheId.isEmpty() && !NameTools::isCacheIdFromData(info)) {
+            // Only a checksum of the filename, cheap to calculate
+            cacheId = NameTools::getCacheId(info);
+            cache->addQuickId(info, cacheId);
+        }
+        Queue::EntryCost cost = Queue::NETWORK;
+        if (cacheId.isEmpty()) {
+            cost = Queue::HASHING;
+        } else if ((!config.refresh && scraperIds.contains(cacheId)) ||
+                   allIds.contains(cacheId)) {
+            cost = Queue::CACHED;
+        } else if (scraperIds.contains(cacheId)) {
+            cost = Queue::REFRESH;
+        }
+        costs.insert(info.absoluteFilePath(), cost);
+        costsLeft[cost]++;
+    }
+    queue->orderByCost(costs);
+
+    if (config.verbosity > 0) {
+        printf("Queue has %d cached, %d to look up, %d to checksum and "
+               "look up and %d to refresh files.\n",
+               costsLeft[Queue::CACHED], costsLeft[Queue::NETWORK],
+               costsLeft[Queue::HASHING], costsLeft[Queue::REFRESH]);
+    }
+}
+
+int Skyscraper::getEstimatedTimeLeft(const Queue::EntryCost cost,
+                                     const int elapsed) {
+    // Average time between two finished entries per cost class, this already
+    // reflects the number of threads working in parallel
+    double interval = elapsed - lastEntryTime;
+    lastEntryTime = elapsed;
+    if (avgCostTime[cost] < 0) {
+        avgCostTime[cost] = interval;
+    } else {
+        avgCostTime[cost] = 0.8 * avgCostTime[cost] + 0.2 * interval;
+    }
+    if (costsLeft[cost] > 0) {
+        costsLeft[cost]--;
+    }
+
+    double fallback = 0.0;
+    for (int c = 0; c < Queue::COSTS; ++c) {
+        fallback = qMax(fallback, avgCostTime[c]);
+    }
+    double estTime = 0.0;
+    for (int c = 0; c < Queue::COSTS; ++c) {
+        estTime +=
+            costsLeft[c] * (avgCostTime[c] < 0 ? fallback : avgCostTime[c]);
+    }
+    return (int)estTime;
+}
+
+void Skyscraper::setMediaFolders(const bool doCacheScraping) {
+    setFolder(doCacheScraping, config.gameListFolder);
+    setFolder(doCacheScraping, config.coversFolder);
+    setFolder(doCacheScraping, config.screenshotsFolder);
+    setFolder(doCacheScraping, config.wheelsFolder);
+    setFolder(doCacheScraping, config.marqueesFolder);
+    setFolder(doCacheScraping, config.texturesFolder);
+    if (config.videos) {
+        setFolder(doCacheScraping, config.videosFolder);
+    }
+    if (config.manuals) {
+        setFolder(doCacheScraping, config.manualsFolder);
+    }
+    if (config.fanart) {
+        setFolder(doCacheScraping, config.fanartsFolder);
+    }
+
+    setFolder(doCacheScraping, config.importFolder, false);
+}
+
 void Skyscraper::setFolder(const bool doCacheScraping, QString &outFolder,
                            const bool createMissingFolder) {
     if (!outFolder.isEmpty()) {
@@ -631,25 +953,36 @@ QString Skyscraper::secsToString(const int &secs) {
 }
 
 void Skyscraper::entryReady(const GameEntry &entry, const QString &output,
-                            const QString &debug) {
+                            const QString &debug, const QString &scraper) {
     QMutexLocker locker(&entryMutex);
 
-    printf("\033[0;32m#%d/%d\033[0m %s\n", currentFile, totalFiles,
-           output.toStdString().c_str());
+    // Every module of the run processes each file once
+    const int totalEntries =
+        totalFiles * (static_cast<int>(extraQueues.size()) + 1);
+    QString module = "";
+    if (!extraQueues.isEmpty()) {
+        module = "[" + scraper + "] ";
+    }
+    printf("\033[0;32m#%d/%d\033[0m %s%s\n", currentFile, totalEntries,
+           module.toStdString().c_str(), output.toStdString().c_str());
 
     if (config.verbosity >= 3) {
         printf("\033[1;33mDebug output:\033[0m\n%s\n",
                debug.toStdString().c_str());
     }
 
+    ModuleCounts &counts = moduleCounts[scraper];
+    counts.entries++;
     if (entry.found) {
         found++;
+        counts.found++;
         avgCompleteness += entry.getCompleteness();
         avgSearchMatch += entry.searchMatch;
         gameEntries.append(entry);
     } else {
         notFound++;
-        QFile skippedFile(skippedFileString);
+        counts.notFound++;
+        QFile skippedFile(getModuleFileString("skipped", scraper));
         skippedFile.open(QIODevice::Append);
         skippedFile.write(entry.absoluteFilePath.toUtf8() + "\n");
         skippedFile.close();
@@ -658,28 +991,51 @@ void Skyscraper::entryReady(const GameEntry &entry, const QString &output,
         }
     }
 
-    printf(
-        "\033[1;34m#%d/%d\033[0m, (\033[1;32m%d\033[0m/\033[1;33m%d\033[0m)\n",
-        currentFile, totalFiles, found, notFound);
+    printf("\033[1;34m#%d/%d\033[0m, %s(\033[1;32m%d\033[0m/"
+           "\033[1;33m%d\033[0m)\n",
+           currentFile, totalEntries, module.toStdString().c_str(),
+           counts.found, counts.notFound);
     int elapsed = timer.elapsed();
-    int estTime = (elapsed / currentFile * totalFiles) - elapsed;
-    if (estTime < 0)
-        estTime = 0;
+    // Entries skipped early by the worker carry no file path, these are the
+    // cheap ones
+    int estTime = getEstimatedTimeLeft(
+        entry.absoluteFilePath.isEmpty()
+            ? Queue::CACHED
+            : queue->getCost(entry.absoluteFilePath),
+        elapsed);
     printf("Elapsed time   : \033[1;33m%s\033[0m\n",
            secsToString(elapsed).toStdString().c_str());
     printf("Est. time left : \033[1;33m%s\033[0m\n\n",
            secsToString(estTime).toStdString().c_str());
 
-    if (!config.onlyMissing && currentFile == config.maxFails &&
-        notFound == config.maxFails && config.scraper != "import" &&
-        config.scraper != "cache") {
-        printf("\033[1;31mThis is NOT going well! I guit! *slams the "
-               "door*\nNo, seriously, out of %d files we had %d misses. So "
-               "either the scraping source is down or you are using a scraping "
-               "source that doesn't support this platform. Please try another "
-               "scraping module (check '--help').\n\nNow exiting...\033[0m\n",
-               config.maxFails, config.maxFails);
-        exit(1);
+    if (!config.onlyMissing && counts.entries == config.maxFails &&
+        counts.notFound == config.maxFails && scraper != "import" &&
+        scraper != "cache") {
+        if (extraQueues.isEmpty()) {
+            printf(
+                "\033[1;31mThis is NOT going well! I guit! *slams the "
+                "door*\nNo, seriously, out of %d files we had %d misses. So "
+                "either the scraping source is down or you are using a "
+                "scraping source that doesn't support this platform. Please "
+                "try another scraping module (check '--help').\n\nNow "
+                "exiting...\033[0m\n",
+                config.maxFails, config.maxFails);
+            exit(1);
+        }
+        // The other modules of the run carry on
+        printf("\033[1;31mOut of %d files '%s' had %d misses. Either the "
+               "scraping source is down or it doesn't support this platform, "
+               "stopping this module...\033[0m\n\n",
+               config.maxFails, scraper.toStdString().c_str(),
+               config.maxFails);
+        if (scraper == config.scraper) {
+            queue->clearAll();
+        }
+        for (int e = 0; e < extraQueues.size(); ++e) {
+            if (extraConfigs.at(e).scraper == scraper) {
+                extraQueues.at(e)->clearAll();
+            }
+        }
     }
     currentFile++;
 
@@ -707,6 +1063,9 @@ void Skyscraper::entryReady(const GameEntry &entry, const QString &output,
             // and quit nicely
             config.pretend = true;
             queue->clearAll();
+            for (auto &extraQueue : extraQueues) {
+                extraQueue->clearAll();
+            }
         }
     }
 }
@@ -715,7 +1074,7 @@ void Skyscraper::checkThreads() {
     QMutexLocker locker(&checkThreadMutex);
 
     doneThreads++;
-    if (doneThreads != config.threads)
+    if (doneThreads != runningThreads)
         return;
 
     if (!config.pretend && config.scraper == "cache") {
@@ -748,6 +1107,7 @@ void Skyscraper::checkThreads() {
                "----\033[0m\n");
         state = NO_INTR;
         cache->write();
+        PassStats::get().save();
         state = SINGLE;
     }
 
@@ -757,6 +1117,16 @@ void Skyscraper::checkThreads() {
     if (!doCacheScraping) {
         printf("Total completion time: \033[1;33m%s\033[0m\n\n",
                secsToString(timer.elapsed()).toStdString().c_str());
+        NetManager::Stats net = NetManager::getStats();
+        if (config.verbosity >= 1 && net.requests > 0) {
+            printf("Network requests: \033[1;33m%d\033[0m (%d new TLS "
+                   "connections, %d via HTTP/2)\n",
+                   net.requests, net.handshakes, net.http2);
+            printf("Average time to first byte: \033[1;33m%d ms\033[0m, "
+                   "complete: \033[1;33m%d ms\033[0m\n\n",
+                   static_cast<int>(net.firstByteMs / net.requests),
+                   static_cast<int>(net.totalMs / net.requests));
+        }
     }
     if (totalFiles > 0) {
         if (found > 0) {
@@ -765,17 +1135,39 @@ void Skyscraper::checkThreads() {
             printf("Average entry completeness: \033[1;33m%d%%\033[0m\n\n",
                    (int)((double)avgCompleteness / (double)found));
         }
-        printf("\033[1;34mTotal number of games: %d\033[0m\n", totalFiles);
+        printf("\033[1;34mTotal number of games: %d\033[0m", totalFiles);
+        if (!extraQueues.isEmpty()) {
+            printf(" (each with %d scraping modules)",
+                   static_cast<int>(extraQueues.size()) + 1);
+        }
+        printf("\n");
         printf("\033[1;32mSuccessfully processed games: %d\033[0m\n", found);
         printf("\033[1;33mSkipped games: %d\033[0m", notFound);
+        if (!extraQueues.isEmpty()) {
+            QStringList perModule;
+            for (auto it = moduleCounts.constBegin();
+                 it != moduleCounts.constEnd(); ++it) {
+                perModule.append(it.key() + " " +
+                                 QString::number(it.value().found) + "/" +
+                                 QString::number(it.value().notFound));
+            }
+            printf(" (processed/skipped by module: %s)",
+                   perModule.join(", ").toStdString().c_str());
+        }
         if (notFound > 0) {
+            QString skipped = getModuleFileString(
+                "skipped", extraQueues.isEmpty() ? config.scraper : "*");
             printf(" (Filenames saved to '\033[1;33m%s/%s\033[0m')",
                    Config::getSkyFolder(Config::SkyFolderType::LOG)
                        .toStdString()
                        .c_str(),
-                   skippedFileString.toStdString().c_str());
+                   skipped.toStdString().c_str());
         }
         printf("\n\n");
+        writeContinueFile(config.scraper, queue);
+        for (int e = 0; e < extraQueues.size(); ++e) {
+            writeContinueFile(extraConfigs.at(e).scraper, extraQueues.at(e));
+        }
     }
 
     if (doCacheScraping) {
@@ -790,10 +1182,48 @@ void Skyscraper::checkThreads() {
         }
     }
 
+    if (config.watch && !watchQuit) {
+        finishWatchBatch();
+        return;
+    }
+
     // All done, now clean up and exit to terminal
     emit finished();
 }
 
+void Skyscraper::writeContinueFile(const QString &scraper,
+                                   QSharedPointer<Queue> workQueue) {
+    if (!QuotaPlanner::get(scraper).isExhausted()) {
+        return;
+    }
+    QStringList left;
+    while (workQueue->hasEntry()) {
+        // takeEntry() also unlocks the mutex locked in hasEntry()
+        left.append(workQueue->takeEntry().absoluteFilePath());
+    }
+    if (left.isEmpty()) {
+        return;
+    }
+    const QString continueFileString = getModuleFileString("continue", scraper);
+    QFile continueFile(continueFileString);
+    if (continueFile.open(QIODevice::WriteOnly)) {
+        continueFile.write(left.join("\n").toUtf8() + "\n");
+        continueFile.close();
+    }
+    QString path = Config::getSkyFolder(Config::SkyFolderType::LOG) % "/" %
+                   continueFileString;
+    printf("\033[1;33mThe request limit of '%s' stopped the run with %d files "
+           "left. Continue with them when the limit has been reset using "
+           "'--includefrom %s'\033[0m\n\n",
+           scraper.toStdString().c_str(), static_cast<int>(left.size()),
+           path.toStdString().c_str());
+}
+
+QString Skyscraper::getModuleFileString(const QString &prefix,
+                                        const QString &scraper) {
+    return prefix + "-" + config.platform + "-" + scraper + ".txt";
+}
+
 QList<QString> Skyscraper::readFileListFrom(const QString &filename) {
     QList<QString> fileList;
     QFileInfo fnInfo(filename);
@@ -870,25 +1300,43 @@ void Skyscraper::loadConfig(const QCommandLineParser &parser) {
                             "gamebase",   "igdb",           "import",
                             "mobygames",  "openretro",      "screenscraper",
                             "thegamesdb", "worldofspectrum"};
+    // Several modules separated by comma scrape the same files concurrently,
+    // the first one is the primary module of the run
+    QStringList extraScrapers;
     if (parser.isSet("s")) {
-        QString _scraper = parser.value("s");
-        if (_scraper == "tgdb") {
-            _scraper = "thegamesdb";
-        } else if (_scraper == "wos" || _scraper == "zxinfo") {
-            /* not using zxinfo bc. backward compability, esp. for resource
-             * cache */
-            _scraper = "worldofspectrum";
-        }
-        if (scrapers.contains(_scraper)) {
-            config.scraper = _scraper;
-        } else {
-            printf("\033[1;31mBummer! Unknown scrapingmodule '%s'. Known "
-                   "scrapers are: %s.\nHint: Try TAB-completion to avoid "
-                   "typos.\033[0m\n",
-                   _scraper.toStdString().c_str(),
-                   scrapers.join(", ").toStdString().c_str());
-            exit(1);
+        QStringList modules;
+        for (QString _scraper : parser.value("s").split(",")) {
+            _scraper = _scraper.trimmed();
+            if (_scraper == "tgdb") {
+                _scraper = "thegamesdb";
+            } else if (_scraper == "wos" || _scraper == "zxinfo") {
+                /* not using zxinfo bc. backward compability, esp. for resource
+                 * cache */
+                _scraper = "worldofspectrum";
+            }
+            if (!scrapers.contains(_scraper)) {
+                printf("\033[1;31mBummer! Unknown scrapingmodule '%s'. Known "
+                       "scrapers are: %s.\nHint: Try TAB-completion to avoid "
+                       "typos.\033[0m\n",
+                       _scraper.toStdString().c_str(),
+                       scrapers.join(", ").toStdString().c_str());
+                exit(1);
+            }
+            if (!modules.contains(_scraper)) {
+                modules.append(_scraper);
+            }
+        }
+        QStringList localScrapers = {"cache", "esgamelist", "import"};
+        for (const auto &module : modules) {
+            if (modules.size() > 1 && localScrapers.contains(module)) {
+                printf("\033[1;31mThe '%s' scraping module can't be combined "
+                       "with other modules.\033[0m\n",
+                       module.toStdString().c_str());
+                exit(1);
+            }
         }
+        config.scraper = modules.takeFirst();
+        extraScrapers = modules;
     }
 
     // 3. Frontend specific configs, overrides platform, main and
@@ -898,6 +1346,10 @@ void Skyscraper::loadConfig(const QCommandLineParser &parser) {
                            inputFolderSet, gameListFolderSet, mediaFolderSet);
     settings.endGroup();
 
+    // Further modules get their own section on top of these, not the one of
+    // the first module
+    const Settings layeredConfig = config;
+
     // 4. Scraping module specific configs, overrides frontend, platform,
     // main and defaults
     settings.beginGroup(config.scraper);
@@ -1012,9 +1464,6 @@ void Skyscraper::loadConfig(const QCommandLineParser &parser) {
         config.minMatch = 0;
     }
 
-    skippedFileString =
-        "skipped-" + config.platform + "-" + config.scraper + ".txt";
-
     // Grab all requested files from cli, if any
     QList<QString> requestedFiles = parser.positionalArguments();
 
@@ -1091,16 +1540,7 @@ void Skyscraper::loadConfig(const QCommandLineParser &parser) {
         config.refresh = true;
     }
 
-    if (!config.userCreds.isEmpty()) {
-        QList<QString> userCreds = config.userCreds.split(":");
-        if (userCreds.length() == 2) {
-            config.user = userCreds.at(0);
-            config.password = userCreds.at(1);
-        } else if (userCreds.length() == 1) {
-            // API key
-            config.password = userCreds.at(0);
-        }
-    }
+    setUserCreds(config);
 
     QFile artworkFile(config.artworkConfig);
     if (artworkFile.open(QIODevice::ReadOnly)) {
@@ -1125,6 +1565,72 @@ void Skyscraper::loadConfig(const QCommandLineParser &parser) {
             resFile.remove(0, resFile.indexOf(resFolder) + resFolder.length());
         config.resources[resFile] = QImage(resFolder % resFile);
     }
+
+    // Each further module applies its own section on the main, platform and
+    // frontend configs, the command line still overrides all
+    if (!extraScrapers.isEmpty() && config.interactive) {
+        printf("\033[1;31mThe 'interactive' flag can't be used with more "
+               "than one scraping module. Now quitting...\033[0m\n");
+        exit(1);
+    }
+    for (const auto &extraScraper : extraScrapers) {
+        Settings extraConfig = layeredConfig;
+        extraConfig.scraper = extraScraper;
+        RuntimeCfg extraRtConf(&extraConfig, &parser);
+        bool unused = false;
+        settings.beginGroup(extraScraper);
+        extraRtConf.applyConfigIni(RuntimeCfg::CfgType::SCRAPER, &settings,
+                                   unused, unused, unused);
+        settings.endGroup();
+        // Credentials on the command line belong to the first module
+        QString userCreds = extraConfig.userCreds;
+        extraRtConf.applyCli(unused, unused, unused);
+        extraConfig.userCreds = userCreds;
+        // Files and folders are resolved once for all modules above
+        extraConfig.inputFolder = config.inputFolder;
+        extraConfig.gameListFolder = config.gameListFolder;
+        extraConfig.mediaFolder = config.mediaFolder;
+        extraConfig.coversFolder = config.coversFolder;
+        extraConfig.screenshotsFolder = config.screenshotsFolder;
+        extraConfig.wheelsFolder = config.wheelsFolder;
+        extraConfig.marqueesFolder = config.marqueesFolder;
+        extraConfig.texturesFolder = config.texturesFolder;
+        extraConfig.videosFolder = config.videosFolder;
+        extraConfig.manualsFolder = config.manualsFolder;
+        extraConfig.fanartsFolder = config.fanartsFolder;
+        extraConfig.importFolder = config.importFolder;
+        extraConfig.artworkXml = config.artworkXml;
+        extraConfig.resources = config.resources;
+        if (!cliFiles.isEmpty() || !config.startAt.isEmpty() ||
+            !config.endAt.isEmpty()) {
+            extraConfig.refresh = true;
+            extraConfig.unattend = true;
+        }
+        extraConfig.subdirs = config.subdirs;
+        extraConfig.searchName = config.searchName;
+        if (extraConfig.minMatchSet == false &&
+            extraConfig.isMatchOneScraper()) {
+            extraConfig.minMatch = 0;
+        }
+        if (!extraConfig.searchName.isEmpty()) {
+            extraConfig.threads = 1;
+        }
+        setUserCreds(extraConfig);
+        extraConfigs.append(extraConfig);
+    }
+}
+
+void Skyscraper::setUserCreds(Settings &cfg) {
+    if (!cfg.userCreds.isEmpty()) {
+        QList<QString> userCreds = cfg.userCreds.split(":");
+        if (userCreds.length() == 2) {
+            cfg.user = userCreds.at(0);
+            cfg.password = userCreds.at(1);
+        } else if (userCreds.length() == 1) {
+            // API key
+            cfg.password = userCreds.at(0);
+        }
+    }
 }
 
 QString Skyscraper::normalizePath(QFileInfo fileInfo) {
@@ -1171,35 +1677,58 @@ void Skyscraper::prepareScraping() {
     }
     loadWhdLoadMap();
 
-    if (config.scraper == "arcadedb" && config.threads != 1) {
+    prepareModule(config, netComm, q);
+    for (auto &extraConfig : extraConfigs) {
+        extraConfig.aliasMap = config.aliasMap;
+        extraConfig.mameMap = config.mameMap;
+        extraConfig.whdLoadMap = config.whdLoadMap;
+        extraConfig.regionPrios = config.regionPrios;
+        extraConfig.langPrios = config.langPrios;
+        prepareModule(extraConfig, netComm, q);
+    }
+}
+
+void Skyscraper::prepareModule(Settings &cfg, NetComm &netComm,
+                               QEventLoop &q) {
+    if (cfg.scraper == "arcadedb" && cfg.threads != 1) {
         printf("\033[1;33mForcing 1 thread to accomodate limits in the "
                "ArcadeDB API\033[0m\n\n");
         // Don't change! This limit was set by request from ArcadeDB
-        config.threads = 1;
-    } else if (config.scraper == "openretro" && config.threads != 1) {
+        cfg.threads = 1;
+    } else if (cfg.scraper == "openretro" && cfg.threads != 1) {
         printf("\033[1;33mForcing 1 thread to accomodate limits in the "
                "OpenRetro API\033[0m\n\n");
         // Don't change! This limit was set by request from OpenRetro
-        config.threads = 1;
-    } else if (config.scraper == "igdb") {
-        prepareIgdb(netComm, q);
-    } else if (config.scraper == "mobygames" && config.threads != 1) {
+        cfg.threads = 1;
+    } else if (cfg.scraper == "igdb") {
+        prepareIgdb(cfg, netComm, q);
+    } else if (cfg.scraper == "mobygames" && cfg.threads != 1) {
         printf(
             "\033[1;33mForcing one thread to accomodate limits in MobyGames "
             "scraping module. Also be aware that MobyGames has a request limit "
             "of 720 requests per hour for a Hobbyist subscription.\033[0m\n\n");
-        config.threads = 1;
-        if (config.password.isEmpty()) {
+        cfg.threads = 1;
+        if (cfg.password.isEmpty()) {
             printf("The MobyGames scraping module requires an API key to "
                    "work. Read more about that here: "
                    "'https://gemba.github.io/skyscraper/"
                    "SCRAPINGMODULES#mobygames'\n");
             exit(1);
         }
-    } else if (config.scraper == "screenscraper") {
-        prepareScreenscraper(netComm, q);
-    } else if (config.scraper == "gamebase") {
-        config.threads = 1;
+    } else if (cfg.scraper == "screenscraper") {
+        prepareScreenscraper(cfg, netComm, q);
+    } else if (cfg.scraper == "gamebase") {
+        cfg.threads = 1;
+    }
+
+    // Request rates are shared by all threads. Don't change! These limits
+    // were set by request from the API providers
+    if (cfg.scraper == "igdb") {
+        // 1.1 seconds per allowed thread, a bit above the 1.0 requested
+        RateLimiter::get().setInterval("api.igdb.com", 1100 / 4);
+    } else if (cfg.scraper == "mobygames") {
+        // 5 seconds (Hobbyist API)
+        RateLimiter::get().setInterval("api.mobygames.com", 5000);
     }
 }
 
@@ -1243,15 +1772,16 @@ void Skyscraper::updateWhdloadDb(NetComm &netComm, QEventLoop &q) {
     }
 }
 
-void Skyscraper::prepareIgdb(NetComm &netComm, QEventLoop &q) {
-    if (config.threads > 4) {
+void Skyscraper::prepareIgdb(Settings &cfg, NetComm &netComm,
+                             QEventLoop &q) {
+    if (cfg.threads > 4) {
         // Don't change! This limit was set by request from IGDB
-        config.threads = 4;
+        cfg.threads = 4;
         printf("\033[1;33mAdjusting to %d threads to accomodate limits in "
                "the IGDB API\033[0m\n\n",
-               config.threads);
+               cfg.threads);
     }
-    if (config.user.isEmpty() || config.password.isEmpty()) {
+    if (cfg.user.isEmpty() || cfg.password.isEmpty()) {
         printf("The IGDB scraping module requires free user credentials to "
                "work. Read more about that here: "
                "'https://gemba.github.io/skyscraper/SCRAPINGMODULES#igdb'\n");
@@ -1269,7 +1799,7 @@ void Skyscraper::prepareIgdb(NetComm &netComm, QEventLoop &q) {
         tokenData = "user;token;0";
     }
     bool updateToken = false;
-    if (config.user != tokenData.split(';').at(0)) {
+    if (cfg.user != tokenData.split(';').at(0)) {
         updateToken = true;
     }
     qlonglong tokenLife = tokenData.split(';').at(2).toLongLong() -
@@ -1278,11 +1808,11 @@ void Skyscraper::prepareIgdb(NetComm &netComm, QEventLoop &q) {
     if (tokenLife < 60 * 60 * 24 * 2) {
         updateToken = true;
     }
-    config.igdbToken = tokenData.split(';').at(1);
+    cfg.igdbToken = tokenData.split(';').at(1);
     if (updateToken) {
         netComm.request("https://id.twitch.tv/oauth2/token"
                         "?client_id=" +
-                            config.user + "&client_secret=" + config.password +
+                            cfg.user + "&client_secret=" + cfg.password +
                             "&grant_type=client_credentials",
                         "");
         q.exec();
@@ -1290,13 +1820,13 @@ void Skyscraper::prepareIgdb(NetComm &netComm, QEventLoop &q) {
             QJsonDocument::fromJson(netComm.getData()).object();
         if (jsonObj.contains("access_token") &&
             jsonObj.contains("expires_in") && jsonObj.contains("token_type")) {
-            config.igdbToken = jsonObj["access_token"].toString();
+            cfg.igdbToken = jsonObj["access_token"].toString();
             printf("...token acquired, ready to scrape!\n");
             tokenLife = (QDateTime::currentMSecsSinceEpoch() / 1000) +
                         jsonObj["expires_in"].toInt();
             if (tokenFile.open(QIODevice::WriteOnly)) {
                 tokenFile.write(
-                    config.user.toUtf8() + ";" + config.igdbToken.toUtf8() +
+                    cfg.user.toUtf8() + ";" + cfg.igdbToken.toUtf8() +
                     ";" +
                     QByteArray::number(
                         (QDateTime::currentMSecsSinceEpoch() / 1000) +
@@ -1318,12 +1848,14 @@ void Skyscraper::prepareIgdb(NetComm &netComm, QEventLoop &q) {
     printf("\n");
 }
 
-void Skyscraper::prepareScreenscraper(NetComm &netComm, QEventLoop &q) {
+void Skyscraper::prepareScreenscraper(Settings &cfg, NetComm &netComm,
+                                      QEventLoop &q) {
     const int threadsFailsafe = 1; // Don't change! This limit was set by
                                    // request from ScreenScraper
-    if (config.user.isEmpty() || config.password.isEmpty()) {
-        if (config.threads > 1) {
-            config.threads = threadsFailsafe;
+    int allowedThreads = threadsFailsafe;
+    if (cfg.user.isEmpty() || cfg.password.isEmpty()) {
+        if (cfg.threads > 1) {
+            cfg.threads = threadsFailsafe;
             printf("\033[1;33mForcing %d thread as this is the anonymous "
                    "limit in the ScreenScraper scraping module. Sign up for "
                    "an account at https://www.screenscraper.fr and support "
@@ -1331,25 +1863,25 @@ void Skyscraper::prepareScreenscraper(NetComm &netComm, QEventLoop &q) {
                    "Skyscraper using the '-u user:password' command line "
                    "option or by setting 'userCreds=\"user:password\"' in "
                    "'%s/config.ini'.\033[0m\n\n",
-                   config.threads,
+                   cfg.threads,
                    Config::getSkyFolder().toStdString().c_str());
         }
     } else {
         printf("Fetching limits for user '\033[1;33m%s\033[0m', just a "
                "sec...\n",
-               config.user.toStdString().c_str());
+               cfg.user.toStdString().c_str());
         netComm.request(
             "https://www.screenscraper.fr/api2/"
             "ssuserInfos.php?devid=muldjord&devpassword=" +
             StrTools::unMagic("204;198;236;130;203;181;203;126;191;167;200;"
                               "198;192;228;169;156") +
-            "&softname=skyscraper" VERSION "&output=json&ssid=" + config.user +
-            "&sspassword=" + config.password);
+            "&softname=skyscraper" VERSION "&output=json&ssid=" + cfg.user +
+            "&sspassword=" + cfg.password);
         q.exec();
         QJsonObject jsonObj =
             QJsonDocument::fromJson(netComm.getData()).object();
         if (jsonObj.isEmpty()) {
-            config.threads = threadsFailsafe;
+            cfg.threads = threadsFailsafe;
             if (netComm.getData().contains("Erreur de login")) {
                 printf("\033[0;31mScreenScraper login error! Please verify "
                        "that you've entered your credentials correctly in "
@@ -1359,33 +1891,38 @@ void Skyscraper::prepareScreenscraper(NetComm &netComm, QEventLoop &q) {
                        "\"USER:PASS\"\033[0m\033[0;31m\nContinuing with "
                        "unregistered user, forcing %d thread...\033[0m\n\n",
                        Config::getSkyFolder().toStdString().c_str(),
-                       config.threads);
+                       cfg.threads);
             } else {
                 printf("\033[1;33mReceived invalid / empty ScreenScraper "
                        "server response, maybe their server is busy / "
                        "overloaded. Forcing 1 thread...\033[0m\n\n");
             }
         } else {
-            int allowedThreads = jsonObj["response"]
-                                     .toObject()["ssuser"]
-                                     .toObject()["maxthreads"]
-                                     .toString()
-                                     .toInt();
-            if (allowedThreads != 0) {
-                if (config.threadsSet && config.threads <= allowedThreads) {
+            int maxThreads = jsonObj["response"]
+                                 .toObject()["ssuser"]
+                                 .toObject()["maxthreads"]
+                                 .toString()
+                                 .toInt();
+            if (maxThreads != 0) {
+                allowedThreads = maxThreads;
+                if (cfg.threadsSet && cfg.threads <= allowedThreads) {
                     printf("User is allowed %d threads, but user has set "
                            "it manually to %d, using the latter value.\n\n",
-                           allowedThreads, config.threads);
+                           allowedThreads, cfg.threads);
                 } else {
-                    config.threads = (allowedThreads <= 8 ? allowedThreads : 8);
+                    cfg.threads = (allowedThreads <= 8 ? allowedThreads : 8);
                     printf("Setting threads to \033[1;32m%d\033[0m as "
                            "allowed for the authenticated Screenscraper "
                            "account.\n\n",
-                           config.threads);
+                           cfg.threads);
                 }
             }
         }
     }
+    // 1.2 seconds per allowed thread, set a bit above 1.0 as requested by the
+    // good folks at ScreenScraper. Don't change!
+    RateLimiter::get().setInterval("screenscraper.fr",
+                                   1200 / qMin(allowedThreads, 8));
 }
 
 void Skyscraper::loadAliasMap() {
@@ -38,7 +38,14 @@
 #include <QElapsedTimer>
 #include <QFile>
 #include <QList>
+#include <QMap>
 #include <QObject>
+#include <QThread>
+#include <QTimer>
+
+#include <atomic>
+
+class Watcher;
 
 class Skyscraper : public QObject {
     Q_OBJECT
@@ -47,9 +54,22 @@ public:
     Skyscraper(const QString &currentDir);
     ~Skyscraper();
     QSharedPointer<Queue> queue;
+    // One queue per further scraping module, see extraConfigs
+    QList<QSharedPointer<Queue>> extraQueues;
     QSharedPointer<NetManager> manager;
-    enum OpMode { SINGLE, NO_INTR, CACHE_EDIT, CACHE_EDIT_DISMISS, THREADED };
+    // WATCH_IDLE: watch mode waits for changed files, no batch is running
+    enum OpMode {
+        SINGLE,
+        NO_INTR,
+        CACHE_EDIT,
+        CACHE_EDIT_DISMISS,
+        THREADED,
+        WATCH_IDLE
+    };
     int state = SINGLE;
+    // Set on Ctrl+C to leave watch mode after the current batch. Written from
+    // the signal handler, an idle watcher polls it
+    std::atomic<bool> watchQuit{false};
 
     void loadConfig(const QCommandLineParser &parser);
     const inline QString getPlatformFileExtensions() {
@@ -59,25 +79,46 @@ public:
 
 public slots:
     void run();
+    // Leaves watch mode while no batch is running
+    void stopWatching();
 
 signals:
     void finished();
 
 private slots:
-    void entryReady(const GameEntry &entry, const QString &output,
-                    const QString &debug);
     void checkThreads();
+    void watchedFilesChanged(const QList<QFileInfo> &files);
 
 private:
     Settings config;
+    // Further modules of '-s' scraping the same files alongside config
+    QList<Settings> extraConfigs;
     QString secsToString(const int &seconds);
     void checkForFolder(QDir &folder, bool create = true);
     void showHint();
     void prepareScraping();
     void prepareFileQueue();
+    void startThreads();
+    void addWorkers(QList<QThread *> &threadList,
+                    QSharedPointer<Queue> workQueue, const Settings &cfg);
+    void entryReady(const GameEntry &entry, const QString &output,
+                    const QString &debug, const QString &scraper);
+    void writeContinueFile(const QString &scraper,
+                           QSharedPointer<Queue> workQueue);
+    // Log file names like 'skipped-<platform>-<scraper>.txt'
+    QString getModuleFileString(const QString &prefix, const QString &scraper);
+    void startWatcher();
+    void startWatchBatch();
+    void startBatch();
+    void finishWatchBatch();
+    void removeGameEntries(const QList<QFileInfo> &files);
+    void scheduleQueue();
+    int getEstimatedTimeLeft(const Queue::EntryCost cost, const int elapsed);
     void updateWhdloadDb(NetComm &netComm, QEventLoop &q);
-    void prepareIgdb(NetComm &netComm, QEventLoop &q);
-    void prepareScreenscraper(NetComm &netComm, QEventLoop &q);
+    void prepareModule(Settings &cfg, NetComm &netComm, QEventLoop &q);
+    void prepareIgdb(Settings &cfg, NetComm &netComm, QEventLoop &q);
+    void prepareScreenscraper(Settings &cfg, NetComm &netComm, QEventLoop &q);
+    void setUserCreds(Settings &cfg);
     void loadAliasMap();
     void loadMameMap();
     void loadWhdLoadMap();
@@ -85,6 +126,7 @@ private:
     void setLangPrios();
     QString normalizePath(QFileInfo fileInfo);
     // void migrate(QString filename);
+    void setMediaFolders(const bool doCacheScraping);
     void setFolder(const bool doCacheScraping, QString &outFolder,
                    const bool createMissingFolder = true);
 
@@ -100,16 +142,37 @@ private:
     QMutex checkThreadMutex;
     QElapsedTimer timer;
     QString gameListFileString;
-    QString skippedFileString;
     int doneThreads;
+    int runningThreads;
     int notFound;
     int found;
+    // Entries, found and not found games by scraping module of the run
+    struct ModuleCounts {
+        int entries = 0;
+        int found = 0;
+        int notFound = 0;
+    };
+    QMap<QString, ModuleCounts> moduleCounts;
     int avgSearchMatch;
     int avgCompleteness;
     int currentFile;
     int totalFiles;
+    int lastEntryTime;
+    int costsLeft[Queue::COSTS];
+    double avgCostTime[Queue::COSTS];
     bool cacheScrapeMode; // config.scraper == "cache"
     bool doCacheScraping; // cacheScrapeMode && pretend == false
+
+    // Watch mode
+    Watcher *watcher = nullptr;
+    QTimer watchQuitTimer;
+    QList<QFileInfo> pendingFiles;
+    QList<QFileInfo> batchFiles;
+    QList<GameEntry> gameListEntries;
+    QString scrapingModule;
+    bool batchRunning = false;
+    bool updateGameList = false;
+    bool watchGameListPass = false;
 };
 
 #endif // SKYSCRAPER_H
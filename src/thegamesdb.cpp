@@ -37,7 +37,7 @@ TheGamesDb::TheGamesDb(Settings *config, QSharedPointer<NetManager> manager)
 
     baseUrl = "https://api.thegamesdb.net/v1";
     searchUrlPre = baseUrl + "/Games/ByGameName?apikey=";
-    gfxUrl = "https://cdn.thegamesdb.net/images/original";
+    gfxUrl = "https://cdn.thegamesdb.net/images/";
 
     fetchOrder.append(GameEntry::Elem::RELEASEDATE);
     fetchOrder.append(GameEntry::Elem::DESCRIPTION);
@@ -62,21 +62,29 @@ void TheGamesDb::getSearchResults(QList<GameEntry> &gameEntries,
             "139;151;215;173;122;206;161;162;200;216;217;123;124;215;200;170;"
             "171;132;158;155;215;120;149;169;140;164;122;154;178;174;160;172;"
             "157;131;210;161;203;137;159;117;205;166;162;139;171;169;210;163") +
-        "&name=" + searchName);
+        "&name=" + searchName +
+        // Request the detail fields with the search, so getGameData() does
+        // not need another request per game
+        "&fields=players,publishers,genres,overview,rating");
     q.exec();
     data = netComm->getData();
 
     jsonDoc = QJsonDocument::fromJson(data);
     if (jsonDoc.isEmpty()) {
+        netComm->dropCachedReply();
         return;
     }
 
-    reqRemaining = jsonDoc.object()["remaining_monthly_allowance"].toInt();
-    if (reqRemaining <= 0)
-        printf("\033[1;31mYou've reached TheGamesdDb's request limit for this "
-               "month.\033[0m\n");
+    // A cached reply carries the allowance of the day it was received
+    if (!netComm->isFromCache()) {
+        reqRemaining = jsonDoc.object()["remaining_monthly_allowance"].toInt();
+        if (reqRemaining <= 0)
+            printf("\033[1;31mYou've reached TheGamesdDb's request limit for "
+                   "this month.\033[0m\n");
+    }
 
     if (jsonDoc.object()["status"].toString() != "Success") {
+        netComm->dropCachedReply();
         return;
     }
     if (jsonDoc.object()["data"].toObject()["count"].toInt() < 1) {
@@ -103,6 +111,10 @@ void TheGamesDb::getSearchResults(QList<GameEntry> &gameEntries,
                    "&fields=game_title,players,release_date,developers,"
                    "publishers,genres,overview,rating";
         game.title = jsonGame["game_title"].toString();
+        if (jsonGame.contains("overview")) {
+            game.miscData =
+                QJsonDocument(jsonGame).toJson(QJsonDocument::Compact);
+        }
         // Remove anything at the end with a parentheses. 'thegamesdb' has a
         // habit of adding for instance '(1993)' to the name.
         game.title = game.title.left(game.title.indexOf("(")).simplified();
@@ -124,6 +136,12 @@ void TheGamesDb::getSearchResults(QList<GameEntry> &gameEntries,
 }
 
 void TheGamesDb::getGameData(GameEntry &game) {
+    if (!game.miscData.isEmpty()) {
+        jsonObj = QJsonDocument::fromJson(game.miscData).object();
+        populateGameEntry(game);
+        return;
+    }
+
     qDebug() << "Per game url:" << game.url;
     netComm->request(game.url);
     q.exec();
@@ -131,10 +149,13 @@ void TheGamesDb::getGameData(GameEntry &game) {
     jsonDoc = QJsonDocument::fromJson(data);
     if (jsonDoc.isEmpty()) {
         printf("No returned json data, is 'thegamesdb' down?\n");
+        netComm->dropCachedReply();
         reqRemaining = 0;
     }
 
-    reqRemaining = jsonDoc.object()["remaining_monthly_allowance"].toInt();
+    if (!netComm->isFromCache()) {
+        reqRemaining = jsonDoc.object()["remaining_monthly_allowance"].toInt();
+    }
 
     if (jsonDoc.object()["data"].toObject()["count"].toInt() < 1) {
         printf("No returned json game document, is 'thegamesdb' down?\n");
@@ -199,64 +220,53 @@ void TheGamesDb::getTags(GameEntry &game) {
     }
 }
 
+QStringList TheGamesDb::getSizes() {
+    // The large variant is still wider than the cache keeps images, the
+    // original is the fallback for images without it
+    if (getMaxImageSize() > 0) {
+        return {"large", "original"};
+    }
+    return {"original"};
+}
+
 void TheGamesDb::getCover(GameEntry &game) {
-    QString req = gfxUrl + "/boxart/front/" + game.id + "-1";
-    game.coverData = downloadMedia(req + ".jpg");
-    if (game.coverData.isEmpty()) {
-        game.coverData = downloadMedia(req + ".png");
+    QStringList reqs;
+    for (const auto &size : getSizes()) {
+        QString req = gfxUrl + size + "/boxart/front/" + game.id + "-1";
+        reqs.append({req + ".jpg", req + ".png"});
     }
+    queueMedia(reqs, game.coverData);
 }
 
 void TheGamesDb::getScreenshot(GameEntry &game) {
-    QString req;
-    QStringList exts = {".jpg", ".png"};
-    // some platforms use screenshot/ rather than screenshots/
-    QStringList pl = {"s/", "/"};
-    int i = 0;
-    do {
-        int k = 0;
-        do {
-            req = gfxUrl + "/screenshot" + pl[k] + game.id + "-1" + exts[i];
-            netComm->request(req);
-            q.exec();
-            k++;
-        } while (k < 2 && netComm->getError() != QNetworkReply::NoError);
-        i++;
-    } while (i < 2 && netComm->getError() != QNetworkReply::NoError);
-
-    QImage image;
-    if (netComm->getError() == QNetworkReply::NoError &&
-        image.loadFromData(netComm->getData())) {
-        game.screenshotData = netComm->getData();
-        qDebug() << "tgdb: got screenshot from " << req;
+    QStringList reqs;
+    for (const auto &size : getSizes()) {
+        // some platforms use screenshot/ rather than screenshots/
+        for (const auto &ext : {".jpg", ".png"}) {
+            for (const auto &pl : {"s/", "/"}) {
+                reqs.append(gfxUrl + size + "/screenshot" + pl + game.id +
+                            "-1" + ext);
+            }
+        }
     }
+    queueMedia(reqs, game.screenshotData);
 }
 
 void TheGamesDb::getWheel(GameEntry &game) {
-    QString req = gfxUrl + "/clearlogo/" + game.id + "-1";
-    game.wheelData = downloadMedia(req + ".png");
-    if (game.wheelData.isEmpty()) {
-        // legacy, try without "-1"
-        req.chop(2);
-        game.wheelData = downloadMedia(req + ".png");
-    }
+    QString req = gfxUrl + "original/clearlogo/" + game.id;
+    // legacy, try without "-1"
+    queueMedia({req + "-1.png", req + ".png"}, game.wheelData);
 }
 
 void TheGamesDb::getMarquee(GameEntry &game) {
-    QString req = gfxUrl + "/graphical/" + game.id + "-g";
-    game.marqueeData = downloadMedia(req + ".jpg");
-    if (game.marqueeData.isEmpty()) {
-        game.marqueeData = downloadMedia(req + ".png");
-    }
+    QString req = gfxUrl + "original/graphical/" + game.id + "-g";
+    queueMedia({req + ".jpg", req + ".png"}, game.marqueeData);
 }
 
 void TheGamesDb::getFanart(GameEntry &game) {
     // https://cdn.thegamesdb.net/images/original/fanart/189-1.jpg
-    QString req = gfxUrl + "/fanart/" + game.id + "-1";
-    game.fanartData = downloadMedia(req + ".jpg");
-    if (game.fanartData.isEmpty()) {
-        game.fanartData = downloadMedia(req + ".png");
-    }
+    QString req = gfxUrl + "original/fanart/" + game.id + "-1";
+    queueMedia({req + ".jpg", req + ".png"}, game.fanartData);
 }
 
 void TheGamesDb::loadMaps() {
@@ -60,6 +60,7 @@ private:
     QJsonDocument jsonDoc;
     QJsonObject jsonObj;
 
+    QStringList getSizes();
     void loadMaps();
     QVariantMap readJson(QString filename);
     QVariantMap platformMap;
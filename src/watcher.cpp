@@ -0,0 +1,175 @@
+/*
+ *  This file is part of skyscraper.
+ *  Copyright 2025 Gemba @ GitHub
+ *
+ *  skyscraper is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  skyscraper is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with skyscraper; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+ */
+
+#include "watcher.h"
+
+#include <QDateTime>
+#include <QDirIterator>
+
+// Files must not have changed for this long before they are reported. This
+// avoids picking up roms that are still being copied
+static const int SETTLEMS = 3000;
+
+Watcher::Watcher(const QString &inputFolder, const QString &nameFilter,
+                 const QDir::Filters &filter, const bool subdirs,
+                 const bool honourIgnoreFiles)
+    : inputFolder(inputFolder), nameFilter(nameFilter), filter(filter),
+      subdirs(subdirs), honourIgnoreFiles(honourIgnoreFiles) {
+    settleTimer.setSingleShot(true);
+    settleTimer.setInterval(SETTLEMS);
+    connect(&fsWatcher, &QFileSystemWatcher::directoryChanged, this,
+            &Watcher::dirChanged);
+    connect(&settleTimer, &QTimer::timeout, this, &Watcher::collectChanges);
+}
+
+void Watcher::start() {
+    knownFiles.clear();
+    for (const auto &dirPath : addDirs(inputFolder)) {
+        for (const auto &info : listFiles(dirPath)) {
+            knownFiles.insert(info.absoluteFilePath(),
+                              info.lastModified().toMSecsSinceEpoch());
+        }
+    }
+}
+
+void Watcher::dirChanged(const QString &path) {
+    dirtyDirs.insert(path);
+    // Restart, so a burst of changes is collected in one go
+    settleTimer.start();
+}
+
+void Watcher::collectChanges() {
+    QList<QFileInfo> changed;
+    QSet<QString> unsettledDirs;
+    qint64 now = QDateTime::currentMSecsSinceEpoch();
+
+    QStringList scanDirs = dirtyDirs.values();
+    dirtyDirs.clear();
+    if (subdirs) {
+        // Newly created subfolders are not watched yet
+        for (const auto &dirPath : QStringList(scanDirs)) {
+            if (QFileInfo::exists(dirPath)) {
+                for (const auto &newDir : addDirs(dirPath)) {
+                    if (!scanDirs.contains(newDir)) {
+                        scanDirs.append(newDir);
+                    }
+                }
+            }
+        }
+    }
+
+    QSet<QString> seenFiles;
+    for (const auto &dirPath : scanDirs) {
+        for (const auto &info : listFiles(dirPath)) {
+            QString filePath = info.absoluteFilePath();
+            seenFiles.insert(filePath);
+            qint64 modified = info.lastModified().toMSecsSinceEpoch();
+            if (knownFiles.contains(filePath) &&
+                knownFiles.value(filePath) >= modified) {
+                continue;
+            }
+            if (now - modified < SETTLEMS) {
+                unsettledDirs.insert(dirPath);
+                continue;
+            }
+            knownFiles.insert(filePath, modified);
+            changed.append(info);
+        }
+    }
+
+    // Forget files deleted from the scanned folders, a file copied there again
+    // later is reported as new
+    QSet<QString> scannedDirs;
+    for (const auto &dirPath : scanDirs) {
+        scannedDirs.insert(dirPath);
+    }
+    for (auto it = knownFiles.begin(); it != knownFiles.end();) {
+        const QString &filePath = it.key();
+        if (!seenFiles.contains(filePath) &&
+            scannedDirs.contains(filePath.left(filePath.lastIndexOf('/')))) {
+            it = knownFiles.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
+    if (!unsettledDirs.isEmpty()) {
+        dirtyDirs.unite(unsettledDirs);
+        settleTimer.start();
+    }
+    if (!changed.isEmpty()) {
+        emit filesChanged(changed);
+    }
+}
+
+bool Watcher::isIgnoredDir(const QString &dirPath) {
+    return honourIgnoreFiles &&
+           QFileInfo::exists(dirPath + "/.skyscraperignoretree") &&
+           dirPath != inputFolder;
+}
+
+QStringList Watcher::addDirs(const QString &rootDir) {
+    QStringList dirs;
+    if (isIgnoredDir(rootDir)) {
+        return dirs;
+    }
+    dirs.append(rootDir);
+    if (subdirs) {
+        QDirIterator dirIt(rootDir, QDir::Dirs | QDir::NoDotAndDotDot,
+                           QDirIterator::Subdirectories);
+        QString exclude = "";
+        while (dirIt.hasNext()) {
+            QString subdir = dirIt.next();
+            if (isIgnoredDir(subdir)) {
+                exclude = subdir;
+            }
+            if (!exclude.isEmpty() &&
+                (subdir == exclude || subdir.startsWith(exclude + "/"))) {
+                continue;
+            }
+            exclude.clear();
+            dirs.append(subdir);
+        }
+    }
+    QStringList watched = fsWatcher.directories();
+    QStringList newDirs;
+    for (const auto &dir : dirs) {
+        if (!watched.contains(dir)) {
+            newDirs.append(dir);
+        }
+    }
+    if (!newDirs.isEmpty()) {
+        QStringList failed = fsWatcher.addPaths(newDirs);
+        if (!failed.isEmpty()) {
+            printf("\033[1;33mCan't watch %d folder(s), e.g. '%s'. On Linux "
+                   "you may need to raise "
+                   "'fs.inotify.max_user_watches'.\033[0m\n",
+                   (int)failed.size(), failed.first().toStdString().c_str());
+        }
+    }
+    return newDirs;
+}
+
+QList<QFileInfo> Watcher::listFiles(const QString &dirPath) {
+    if (honourIgnoreFiles && QFileInfo::exists(dirPath + "/.skyscraperignore")) {
+        return QList<QFileInfo>();
+    }
+    QDir dir(dirPath, nameFilter, QDir::Name, filter);
+    return dir.entryInfoList();
+}
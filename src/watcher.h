@@ -0,0 +1,70 @@
+/*
+ *  This file is part of skyscraper.
+ *  Copyright 2025 Gemba @ GitHub
+ *
+ *  skyscraper is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  skyscraper is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with skyscraper; if not, write to the Free Software
+ *  Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+ */
+
+#ifndef WATCHER_H
+#define WATCHER_H
+
+#include <QDir>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+
+class Watcher : public QObject {
+    Q_OBJECT
+
+public:
+    Watcher(const QString &inputFolder, const QString &nameFilter,
+            const QDir::Filters &filter, const bool subdirs,
+            const bool honourIgnoreFiles);
+    // Takes a snapshot of the existing files and starts watching. Only files
+    // added or modified afterwards will be reported
+    void start();
+
+signals:
+    void filesChanged(const QList<QFileInfo> &files);
+
+private slots:
+    void dirChanged(const QString &path);
+    void collectChanges();
+
+private:
+    bool isIgnoredDir(const QString &dirPath);
+    QStringList addDirs(const QString &rootDir);
+    QList<QFileInfo> listFiles(const QString &dirPath);
+
+    QString inputFolder;
+    QString nameFilter;
+    QDir::Filters filter;
+    bool subdirs;
+    bool honourIgnoreFiles;
+
+    QFileSystemWatcher fsWatcher;
+    QTimer settleTimer;
+    QSet<QString> dirtyDirs;
+    // absolute file path to last modification time in msecs
+    QHash<QString, qint64> knownFiles;
+};
+
+#endif // WATCHER_H
@@ -26,12 +26,17 @@ HEADERS += ../../src/abstractscraper.h  \
              ../../src/gameentry.h \
              ../../src/igdb.h \
              ../../src/mobygames.h \
+             ../../src/iolimiter.h \
              ../../src/nametools.h \
              ../../src/netcomm.h \
+             ../../src/netfixtures.h \
              ../../src/netmanager.h \
              ../../src/openretro.h \
+             ../../src/passstats.h \
              ../../src/platform.h \
              ../../src/queue.h \ 
+             ../../src/ratelimiter.h \
+             ../../src/responsecache.h \
              ../../src/screenscraper.h \
              ../../src/settings.h \
              ../../src/strtools.h 
@@ -47,12 +52,17 @@ SOURCES +=  test_getsearchnames.cpp \
              ../../src/gameentry.cpp \
              ../../src/igdb.cpp \
              ../../src/mobygames.cpp \
+             ../../src/iolimiter.cpp \
              ../../src/nametools.cpp \
              ../../src/netcomm.cpp \
+             ../../src/netfixtures.cpp \
              ../../src/netmanager.cpp \
              ../../src/openretro.cpp \
+             ../../src/passstats.cpp \
              ../../src/platform.cpp \
              ../../src/queue.cpp \
+             ../../src/ratelimiter.cpp \
+             ../../src/responsecache.cpp \
              ../../src/screenscraper.cpp \
              ../../src/settings.cpp \
              ../../src/strtools.cpp
@@ -0,0 +1,67 @@
+#include "netfixtures.h"
+
+#include <QTemporaryDir>
+#include <QTest>
+
+class TestNetFixtures : public QObject {
+    Q_OBJECT
+
+private:
+    QTemporaryDir tmpDir;
+
+private slots:
+    void initTestCase() { QVERIFY(tmpDir.isValid()); }
+
+    void testOffWithoutFolder() {
+        NetFixtures::get().setMode(NetFixtures::RECORD, "");
+        QCOMPARE(NetFixtures::get().getMode(), NetFixtures::OFF);
+    }
+
+    void testRecordReplay() {
+        NetFixtures::get().setMode(NetFixtures::RECORD, tmpDir.path());
+        QCOMPARE(NetFixtures::get().getMode(), NetFixtures::RECORD);
+
+        NetFixtures::Fixture fixture;
+        QVERIFY(!NetFixtures::get().read("0123abcd", fixture));
+
+        fixture.url = "https://api.example.com/games?id=1";
+        fixture.status = 200;
+        fixture.latency = 321;
+        fixture.headers.append(
+            qMakePair(QByteArray("Content-Type"), QByteArray("text/json")));
+        fixture.data = "{\"id\": 1}";
+        NetFixtures::get().write("0123abcd", fixture);
+
+        NetFixtures::get().setMode(NetFixtures::REPLAY_TIMED, tmpDir.path());
+        NetFixtures::Fixture replayed;
+        QVERIFY(NetFixtures::get().read("0123abcd", replayed));
+        QCOMPARE(replayed.url, fixture.url);
+        QCOMPARE(replayed.status, 200);
+        QCOMPARE(replayed.error, 0);
+        QCOMPARE(replayed.latency, fixture.latency);
+        QCOMPARE(replayed.headers, fixture.headers);
+        QCOMPARE(replayed.data, fixture.data);
+    }
+
+    void testStripCredentials() {
+        QCOMPARE(NetFixtures::stripCredentials(
+                     "https://api.mobygames.com/v1/games/123/platforms/"
+                     "4?api_key=secret"),
+                 QString("https://api.mobygames.com/v1/games/123/platforms/4"));
+        QCOMPARE(NetFixtures::stripCredentials(
+                     "https://id.twitch.tv/oauth2/"
+                     "token?client_id=id&client_secret=secret&grant_type="
+                     "client_credentials"),
+                 QString("https://id.twitch.tv/oauth2/"
+                         "token?grant_type=client_credentials"));
+        QCOMPARE(NetFixtures::stripCredentials(
+                     "https://www.screenscraper.fr/api2/"
+                     "jeuInfos.php?devid=a&devpassword=b&softname=c&ssid=d&"
+                     "sspassword=e"),
+                 QString("https://www.screenscraper.fr/api2/"
+                         "jeuInfos.php?softname=c"));
+    }
+};
+
+QTEST_MAIN(TestNetFixtures)
+#include "test_netfixtures.moc"
@@ -0,0 +1,14 @@
+TEMPLATE = app
+TARGET = test_netfixtures
+DEPENDPATH += .
+INCLUDEPATH += ../../src
+CONFIG += debug
+QT += core testlib
+QMAKE_CXXFLAGS += -std=c++17
+
+CONFIG(release, debug|release):DEFINES += QT_NO_DEBUG_OUTPUT
+
+HEADERS += ../../src/netfixtures.h
+
+SOURCES += test_netfixtures.cpp \
+           ../../src/netfixtures.cpp
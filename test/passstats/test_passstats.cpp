@@ -0,0 +1,82 @@
+#include "passstats.h"
+
+#include <QTemporaryDir>
+#include <QTest>
+
+class TestPassStats : public QObject {
+    Q_OBJECT
+
+private:
+    QTemporaryDir dir;
+    const QStringList variants = {"exact", "nosubtitle", "numeral"};
+
+    void addTries(const QString &platform, const QString &scraper,
+                  const QString &variant, int tries, int hits) {
+        for (int i = 0; i < tries; i++) {
+            PassStats::get().addTry(platform, scraper, variant);
+        }
+        for (int i = 0; i < hits; i++) {
+            PassStats::get().addHit(platform, scraper, variant);
+        }
+    }
+
+private slots:
+    void testModuleOrder() {
+        PassStats::get().load(dir.filePath("passstats.json"));
+        // Too few hits to tell
+        addTries("snes", "thegamesdb", "exact", 10, 2);
+        addTries("snes", "thegamesdb", "numeral", 5, 3);
+        addTries("snes", "thegamesdb", "nosubtitle", 8, 1);
+        QCOMPARE(PassStats::get().getOrder("snes", "thegamesdb", variants,
+                                           false),
+                 QList<int>({0, 1, 2}));
+        addTries("snes", "thegamesdb", "numeral", 5, 4);
+        // The exact name matched now and then, it stays first
+        QCOMPARE(PassStats::get().getOrder("snes", "thegamesdb", variants,
+                                           false),
+                 QList<int>({0, 2, 1}));
+        // Other platforms and modules are not affected
+        QCOMPARE(
+            PassStats::get().getOrder("nes", "thegamesdb", variants, false),
+            QList<int>({0, 1, 2}));
+        QCOMPARE(
+            PassStats::get().getOrder("snes", "mobygames", variants, false),
+            QList<int>({0, 1, 2}));
+    }
+
+    void testFirstNeverMatched() {
+        addTries("psx", "mobygames", "exact", 30, 0);
+        addTries("psx", "mobygames", "numeral", 30, 12);
+        QCOMPARE(
+            PassStats::get().getOrder("psx", "mobygames", variants, false),
+            QList<int>({2, 0, 1}));
+        // Pinned for modules with many candidates per search
+        QCOMPARE(PassStats::get().getOrder("psx", "mobygames", variants, true),
+                 QList<int>({0, 2, 1}));
+    }
+
+    void testFewerVariants() {
+        // The counted variants are found by kind, not by position
+        QCOMPARE(PassStats::get().getOrder("snes", "thegamesdb",
+                                           {"exact", "numeral"}, false),
+                 QList<int>({0, 1}));
+        QCOMPARE(
+            PassStats::get().getOrder("psx", "mobygames", {"numeral"}, false),
+            QList<int>({0}));
+    }
+
+    void testPersist() {
+        PassStats::get().save();
+        PassStats::get().load(dir.filePath("passstats.json"));
+        QCOMPARE(PassStats::get().getOrder("snes", "thegamesdb", variants,
+                                           false),
+                 QList<int>({0, 2, 1}));
+        PassStats::get().load(dir.filePath("missing.json"));
+        QCOMPARE(PassStats::get().getOrder("snes", "thegamesdb", variants,
+                                           false),
+                 QList<int>({0, 1, 2}));
+    }
+};
+
+QTEST_MAIN(TestPassStats)
+#include "test_passstats.moc"
@@ -0,0 +1,79 @@
+#include "queue.h"
+
+#include <QTest>
+
+class TestQueue : public QObject {
+    Q_OBJECT
+
+private:
+    Queue q;
+
+    QStringList fileNames() {
+        QStringList names;
+        for (const auto &info : q) {
+            names.append(info.fileName());
+        }
+        return names;
+    }
+
+private slots:
+    void init() {
+        q.clear();
+        for (const auto &fn :
+             {"Alpha (USA).zip", "Beta, The (Europe).zip", "Gamma [!].7z",
+              "Delta (Japan).zip", "epsilon.ZIP"}) {
+            q.append(QFileInfo("/roms/" + QString(fn)));
+        }
+    }
+
+    void testExcludePattern() {
+        q.filterFiles("*(Japan)*,*.7z");
+        QCOMPARE(fileNames(), QStringList({"Alpha (USA).zip",
+                                           "Beta, The (Europe).zip",
+                                           "epsilon.ZIP"}));
+    }
+
+    void testIncludePattern() {
+        q.filterFiles("*.zip", true);
+        QCOMPARE(fileNames(),
+                 QStringList({"Alpha (USA).zip", "Beta, The (Europe).zip",
+                              "Delta (Japan).zip"}));
+    }
+
+    void testEscapedComma() {
+        q.filterFiles("Beta\\, The*", true);
+        QCOMPARE(fileNames(), QStringList({"Beta, The (Europe).zip"}));
+    }
+
+    void testSpecialChars() {
+        q.filterFiles("Gamma [!].7z;epsilon.*", true);
+        QCOMPARE(fileNames(), QStringList({"Gamma [!].7z", "epsilon.ZIP"}));
+    }
+
+    void testRemoveFiles() {
+        q.removeFiles({"/roms/Gamma [!].7z", "/roms/Alpha (USA).zip",
+                       "/roms/notinqueue.zip"});
+        QCOMPARE(fileNames(),
+                 QStringList({"Beta, The (Europe).zip", "Delta (Japan).zip",
+                              "epsilon.ZIP"}));
+    }
+
+    void testOrderByLocality() {
+        // Nonexistent files have no inode, they keep their order per folder
+        q.clear();
+        for (const auto &fp : {"/roms/b/x.zip", "/roms/a/y.zip",
+                               "/roms/b/a.zip", "/roms/a/z.zip"}) {
+            q.append(QFileInfo(fp));
+        }
+        q.orderByLocality();
+        QStringList paths;
+        for (const auto &info : q) {
+            paths.append(info.absoluteFilePath());
+        }
+        QCOMPARE(paths, QStringList({"/roms/a/y.zip", "/roms/a/z.zip",
+                                     "/roms/b/x.zip", "/roms/b/a.zip"}));
+    }
+};
+
+QTEST_MAIN(TestQueue)
+#include "test_queue.moc"
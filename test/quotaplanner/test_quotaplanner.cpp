@@ -0,0 +1,49 @@
+#include "quotaplanner.h"
+
+#include <QTest>
+
+class TestQuotaPlanner : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testUnknown() {
+        QCOMPARE(QuotaPlanner::get("screenscraper").getGamesLeft(), -1);
+        QVERIFY(QuotaPlanner::get("screenscraper").hasBudget(4));
+    }
+
+    void testCostPerGame() {
+        QuotaPlanner &planner = QuotaPlanner::get("screenscraper");
+        planner.reportRemaining(1000);
+        QCOMPARE(planner.getGamesLeft(), 1000);
+        // Games costing three requests each
+        for (int r = 997; r >= 900; r -= 3) {
+            planner.reportRemaining(r);
+        }
+        // Stale report of another thread
+        planner.reportRemaining(950);
+        int left = planner.getGamesLeft();
+        QVERIFY(left >= 290 && left <= 310);
+    }
+
+    void testReserve() {
+        QuotaPlanner &planner = QuotaPlanner::get("screenscraper");
+        QVERIFY(!planner.isExhausted());
+        for (int r = 898; r >= 10; r -= 3) {
+            planner.reportRemaining(r);
+        }
+        // Not enough for one more game in each of four threads
+        QVERIFY(planner.hasBudget(1));
+        QVERIFY(!planner.hasBudget(4));
+        QVERIFY(planner.isExhausted());
+    }
+
+    void testPerModule() {
+        QuotaPlanner &planner = QuotaPlanner::get("mobygames");
+        QVERIFY(&planner != &QuotaPlanner::get("screenscraper"));
+        QVERIFY(!planner.isExhausted());
+        QCOMPARE(planner.getGamesLeft(), -1);
+    }
+};
+
+QTEST_MAIN(TestQuotaPlanner)
+#include "test_quotaplanner.moc"
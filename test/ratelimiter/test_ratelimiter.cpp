@@ -0,0 +1,68 @@
+#include "ratelimiter.h"
+
+#include <QElapsedTimer>
+#include <QTest>
+
+class TestRateLimiter : public QObject {
+    Q_OBJECT
+
+private slots:
+    void testUnlimitedHost() {
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < 5; i++) {
+            RateLimiter::get().acquire(QUrl("https://unlimited.example.org/"));
+        }
+        QVERIFY(timer.elapsed() < 50);
+    }
+
+    void testInterval() {
+        RateLimiter::get().setInterval("limited.example.org", 100);
+        QElapsedTimer timer;
+        timer.start();
+        // First token is available right away, then one per interval
+        for (int i = 0; i < 4; i++) {
+            RateLimiter::get().acquire(QUrl("https://limited.example.org/a"));
+        }
+        QVERIFY(timer.elapsed() >= 300);
+    }
+
+    void testSubdomain() {
+        RateLimiter::get().setInterval("sub.example.org", 100);
+        QElapsedTimer timer;
+        timer.start();
+        RateLimiter::get().acquire(QUrl("https://api.sub.example.org/"));
+        RateLimiter::get().acquire(QUrl("https://media.sub.example.org/"));
+        QVERIFY(timer.elapsed() >= 100);
+        // Hosts only sharing the suffix are not limited
+        timer.restart();
+        RateLimiter::get().acquire(QUrl("https://notsub.example.org/"));
+        RateLimiter::get().acquire(QUrl("https://notsub.example.org/"));
+        QVERIFY(timer.elapsed() < 50);
+    }
+
+    void testPause() {
+        QElapsedTimer timer;
+        timer.start();
+        RateLimiter::get().pause(QUrl("https://busy.example.org/"), 1);
+        RateLimiter::get().acquire(QUrl("https://busy.example.org/x"));
+        QVERIFY(timer.elapsed() >= 1000);
+    }
+
+    void testBreaker() {
+        QUrl url("https://overloaded.example.org/");
+        for (int i = 1; i < 5; i++) {
+            QVERIFY(!RateLimiter::get().reportFailure(url));
+        }
+        // Only failures in a row open the breaker
+        RateLimiter::get().reportSuccess(url);
+        for (int i = 1; i < 5; i++) {
+            QVERIFY(!RateLimiter::get().reportFailure(url));
+        }
+        QVERIFY(RateLimiter::get().reportFailure(url));
+        QVERIFY(!RateLimiter::get().reportFailure(url));
+    }
+};
+
+QTEST_MAIN(TestRateLimiter)
+#include "test_ratelimiter.moc"
@@ -0,0 +1,14 @@
+TEMPLATE = app
+TARGET = test_ratelimiter
+DEPENDPATH += .
+INCLUDEPATH += ../../src
+CONFIG += debug
+QT += core testlib
+QMAKE_CXXFLAGS += -std=c++17
+
+CONFIG(release, debug|release):DEFINES += QT_NO_DEBUG_OUTPUT
+
+HEADERS += ../../src/ratelimiter.h
+
+SOURCES += test_ratelimiter.cpp \
+           ../../src/ratelimiter.cpp
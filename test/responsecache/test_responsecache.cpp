@@ -0,0 +1,60 @@
+#include "responsecache.h"
+
+#include <QTemporaryDir>
+#include <QTest>
+
+class TestResponseCache : public QObject {
+    Q_OBJECT
+
+private:
+    QTemporaryDir tmpDir;
+
+private slots:
+    void initTestCase() {
+        QVERIFY(tmpDir.isValid());
+        ResponseCache::get().setFolder(tmpDir.path());
+    }
+
+    void testKeyNormalised() {
+        QString key = ResponseCache::getKey(
+            "https://api.example.com/games?b=2&a=1", "GET", "");
+        QCOMPARE(ResponseCache::getKey(
+                     "HTTPS://API.Example.com:443/games?a=1&b=2#top", "get",
+                     ""),
+                 key);
+        QVERIFY(ResponseCache::getKey("https://api.example.com/games?a=1",
+                                      "GET", "") != key);
+        QVERIFY(ResponseCache::getKey("https://api.example.com/games?b=2&a=1",
+                                      "POST", "") != key);
+    }
+
+    void testKeyBody() {
+        QString url = "https://api.example.com/search/";
+        QCOMPARE(ResponseCache::getKey(url, "POST", "search \"x\";\n"),
+                 ResponseCache::getKey(url, "POST", "search \"x\";"));
+        QVERIFY(ResponseCache::getKey(url, "POST", "search \"x\";") !=
+                ResponseCache::getKey(url, "POST", "search \"y\";"));
+    }
+
+    void testReadWrite() {
+        QString key = ResponseCache::getKey("https://example.com/a", "GET", "");
+        ResponseCache::Entry entry;
+        QVERIFY(!ResponseCache::get().read(key, entry));
+
+        entry.timestamp = 1700000000;
+        entry.error = 203;
+        entry.headers.append(qMakePair(QByteArray("ETag"), QByteArray("\"x\"")));
+        entry.data = "not found";
+        ResponseCache::get().write(key, entry);
+
+        ResponseCache::Entry cached;
+        QVERIFY(ResponseCache::get().read(key, cached));
+        QCOMPARE(cached.timestamp, entry.timestamp);
+        QCOMPARE(cached.error, entry.error);
+        QCOMPARE(cached.data, entry.data);
+        QCOMPARE(ResponseCache::getHeader(cached, "etag"), QByteArray("\"x\""));
+    }
+};
+
+QTEST_MAIN(TestResponseCache)
+#include "test_responsecache.moc"
@@ -0,0 +1,14 @@
+TEMPLATE = app
+TARGET = test_responsecache
+DEPENDPATH += .
+INCLUDEPATH += ../../src
+CONFIG += debug
+QT += core testlib
+QMAKE_CXXFLAGS += -std=c++17
+
+CONFIG(release, debug|release):DEFINES += QT_NO_DEBUG_OUTPUT
+
+HEADERS += ../../src/responsecache.h
+
+SOURCES += test_responsecache.cpp \
+           ../../src/responsecache.cpp
@@ -18,6 +18,7 @@ HEADERS += test_settings.h \
            ../../src/cli.h \
            ../../src/config.h \
            ../../src/gameentry.h \
+           ../../src/iolimiter.h \
            ../../src/nametools.h \
            ../../src/platform.h \
            ../../src/queue.h \
@@ -28,6 +29,7 @@ SOURCES += test_settings.cpp \
            ../../src/cli.cpp \
            ../../src/config.cpp \
            ../../src/gameentry.cpp \
+           ../../src/iolimiter.cpp \
            ../../src/nametools.cpp \
            ../../src/platform.cpp \
            ../../src/queue.cpp \           